@@ -0,0 +1,197 @@
+#pragma once
+#include <string>
+#include <map>
+#include <vector>
+#include <stdexcept>
+#include "QuantileSketch.h"
+#include "TopKTracker.h"
+#include "../Maintenance/MaintenanceRecord.h"
+
+using namespace std;
+
+// Streaming maintenance cost statistics for one train (or, after merging,
+// for a whole fleet). Fed one record at a time and never keeps raw records:
+// quantiles come from QuantileSketch, heaviest parts from TopKTracker.
+// Rolling windows are calendar months; only the latest `windowCount` are kept,
+// each with its own overall, per-part and per-technician sketches.
+class CostAnalytics {
+private:
+    struct MonthWindow {
+        QuantileSketch overall;
+        map<string, QuantileSketch> byPart;
+        map<string, QuantileSketch> byTechnician;
+    };
+
+    int windowCount;
+    QuantileSketch overall;
+    map<string, QuantileSketch> byPart;
+    map<string, QuantileSketch> byTechnician;
+    map<string, MonthWindow> byMonth;  // "YYYY-MM" -> costs in that month
+    TopKTracker topParts;
+
+    static constexpr int GROUP_SKETCH_K = 64;  // smaller sketches per part/technician
+
+    // Accepts "YYYY-MM-DD" or "DD/MM/YYYY" (see MaintenanceRecord::date)
+    static string monthOf(const string& date) {
+        if (date.size() >= 7 && date[4] == '-') {
+            return date.substr(0, 7);
+        }
+        if (date.size() >= 10 && date[2] == '/' && date[5] == '/') {
+            return date.substr(6, 4) + "-" + date.substr(3, 2);
+        }
+        return "";
+    }
+
+    static void mergeGroups(map<string, QuantileSketch>& into,
+                            const map<string, QuantileSketch>& from) {
+        for (const auto& [key, sketch] : from) {
+            auto it = into.find(key);
+            if (it == into.end()) {
+                into.emplace(key, sketch);
+            } else {
+                it->second.merge(sketch);
+            }
+        }
+    }
+
+    static void addToGroup(map<string, QuantileSketch>& groups, const string& key, double cost) {
+        groups.try_emplace(key, GROUP_SKETCH_K).first->second.add(cost);
+    }
+
+    void trimWindows() {
+        while ((int)byMonth.size() > windowCount) {
+            byMonth.erase(byMonth.begin());
+        }
+    }
+
+    static double groupQuantile(const map<string, QuantileSketch>& groups,
+                                const string& key, double q) {
+        auto it = groups.find(key);
+        if (it == groups.end()) {
+            throw runtime_error("[CostAnalytics] No records for: " + key);
+        }
+        return it->second.quantile(q);
+    }
+
+    // Combines the latest `months` windows; `pick` returns the sketch of one
+    // window to include, or nullptr if that window has none
+    template <typename Pick>
+    QuantileSketch combineWindows(int months, Pick pick) const {
+        QuantileSketch combined;
+        int taken = 0;
+        for (auto it = byMonth.rbegin(); it != byMonth.rend() && taken < months; ++it, ++taken) {
+            if (const QuantileSketch* sketch = pick(it->second)) {
+                combined.merge(*sketch);
+            }
+        }
+        return combined;
+    }
+
+    double rollingGroupQuantile(map<string, QuantileSketch> MonthWindow::* groups,
+                                const string& key, int months, double q) const {
+        QuantileSketch combined = combineWindows(months, [&](const MonthWindow& window) {
+            auto it = (window.*groups).find(key);
+            return it == (window.*groups).end() ? nullptr : &it->second;
+        });
+        if (combined.getCount() == 0) {
+            throw runtime_error("[CostAnalytics] No records in window for: " + key);
+        }
+        return combined.quantile(q);
+    }
+
+public:
+    CostAnalytics(int windowCount = 12)
+        : windowCount(windowCount), topParts(32) {
+        if (windowCount <= 0) {
+            throw invalid_argument("[CostAnalytics] Window count must be positive");
+        }
+    }
+
+    void add(const MaintenanceRecord& record) {
+        double cost = record.getCost();
+        overall.add(cost);
+        addToGroup(byPart, record.getPartName(), cost);
+        addToGroup(byTechnician, record.getTechnician(), cost);
+        topParts.add(record.getPartName(), cost);
+
+        string month = monthOf(record.getDate());
+        if (month.empty()) {
+            return;
+        }
+        // Older than every retained window -> already rolled off
+        if ((int)byMonth.size() == windowCount && month < byMonth.begin()->first) {
+            return;
+        }
+        MonthWindow& window = byMonth[month];
+        window.overall.add(cost);
+        addToGroup(window.byPart, record.getPartName(), cost);
+        addToGroup(window.byTechnician, record.getTechnician(), cost);
+        trimWindows();
+    }
+
+    // Combine another train's statistics into this one (fleet roll-up)
+    void merge(const CostAnalytics& other) {
+        overall.merge(other.overall);
+        mergeGroups(byPart, other.byPart);
+        mergeGroups(byTechnician, other.byTechnician);
+        for (const auto& [month, window] : other.byMonth) {
+            MonthWindow& into = byMonth[month];
+            into.overall.merge(window.overall);
+            mergeGroups(into.byPart, window.byPart);
+            mergeGroups(into.byTechnician, window.byTechnician);
+        }
+        trimWindows();
+        topParts.merge(other.topParts);
+    }
+
+    double quantile(double q) const {
+        return overall.quantile(q);
+    }
+
+    double partQuantile(const string& partName, double q) const {
+        return groupQuantile(byPart, partName, q);
+    }
+
+    double technicianQuantile(const string& technician, double q) const {
+        return groupQuantile(byTechnician, technician, q);
+    }
+
+    // Quantile over the latest `months` retained monthly windows
+    double rollingQuantile(int months, double q) const {
+        return combineWindows(months, [](const MonthWindow& window) {
+            return &window.overall;
+        }).quantile(q);
+    }
+
+    double rollingPartQuantile(const string& partName, int months, double q) const {
+        return rollingGroupQuantile(&MonthWindow::byPart, partName, months, q);
+    }
+
+    double rollingTechnicianQuantile(const string& technician, int months, double q) const {
+        return rollingGroupQuantile(&MonthWindow::byTechnician, technician, months, q);
+    }
+
+    vector<TopKEntry> getTopParts(size_t k) const {
+        return topParts.top(k);
+    }
+
+    vector<string> getWindows() const {
+        vector<string> months;
+        for (const auto& entry : byMonth) {
+            months.push_back(entry.first);
+        }
+        return months;
+    }
+
+    uint64_t getCount() const {
+        return overall.getCount();
+    }
+
+    void clear() {
+        overall.clear();
+        byPart.clear();
+        byTechnician.clear();
+        byMonth.clear();
+        topParts.clear();
+    }
+};
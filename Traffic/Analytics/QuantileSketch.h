@@ -0,0 +1,172 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+// KLL-style streaming quantile sketch.
+// Items live in levels of "compactors"; an item at level h stands for 2^h
+// original values. When a level fills up it is sorted and every other item is
+// promoted to the level above, so memory stays around O(k log(n/k)) no matter
+// how many values are added. Two sketches merge by concatenating levels.
+class QuantileSketch {
+private:
+    int k;
+    vector<vector<double>> levels;
+    uint64_t count;
+    double minValue;
+    double maxValue;
+    uint64_t rngState;  // xorshift state; picks which half survives a compaction
+
+    size_t capacity(size_t level) const {
+        size_t depth = levels.size() - 1 - level;
+        double cap = k * pow(2.0 / 3.0, (double)depth);
+        return max((size_t)2, (size_t)ceil(cap));
+    }
+
+    size_t nextBit() {
+        rngState ^= rngState << 13;
+        rngState ^= rngState >> 7;
+        rngState ^= rngState << 17;
+        return (size_t)(rngState >> 63);
+    }
+
+    void compress() {
+        for (size_t h = 0; h < levels.size(); h++) {
+            if (levels[h].size() < capacity(h)) {
+                continue;
+            }
+            if (h + 1 == levels.size()) {
+                levels.emplace_back();
+            }
+
+            vector<double>& level = levels[h];
+            sort(level.begin(), level.end());
+
+            // An odd item out stays behind at this level
+            size_t pairs = level.size() / 2;
+            bool hasLeftover = level.size() % 2 == 1;
+            double leftover = hasLeftover ? level.back() : 0.0;
+
+            size_t offset = nextBit();
+            for (size_t i = 0; i < pairs; i++) {
+                levels[h + 1].push_back(level[2 * i + offset]);
+            }
+
+            level.clear();
+            if (hasLeftover) {
+                level.push_back(leftover);
+            }
+        }
+    }
+
+public:
+    QuantileSketch(int k = 200)
+        : k(k), levels(1), count(0), minValue(0.0), maxValue(0.0), rngState(0x9E3779B97F4A7C15ULL) {
+        if (k < 8) {
+            throw invalid_argument("[QuantileSketch] k must be at least 8");
+        }
+    }
+
+    void add(double value) {
+        if (count == 0) {
+            minValue = maxValue = value;
+        } else {
+            minValue = min(minValue, value);
+            maxValue = max(maxValue, value);
+        }
+        count++;
+
+        levels[0].push_back(value);
+        if (levels[0].size() >= capacity(0)) {
+            compress();
+        }
+    }
+
+    void merge(const QuantileSketch& other) {
+        if (other.count == 0) {
+            return;
+        }
+        if (count == 0) {
+            minValue = other.minValue;
+            maxValue = other.maxValue;
+        } else {
+            minValue = min(minValue, other.minValue);
+            maxValue = max(maxValue, other.maxValue);
+        }
+        count += other.count;
+
+        if (levels.size() < other.levels.size()) {
+            levels.resize(other.levels.size());
+        }
+        for (size_t h = 0; h < other.levels.size(); h++) {
+            levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+        }
+        compress();
+    }
+
+    // q in [0, 1]; 0.5 = median, 0.99 = p99
+    double quantile(double q) const {
+        if (count == 0) {
+            throw runtime_error("[QuantileSketch] No values available");
+        }
+        if (q <= 0.0) {
+            return minValue;
+        }
+        if (q >= 1.0) {
+            return maxValue;
+        }
+
+        vector<pair<double, uint64_t>> weighted;
+        uint64_t totalWeight = 0;
+        for (size_t h = 0; h < levels.size(); h++) {
+            uint64_t weight = (uint64_t)1 << h;
+            for (double value : levels[h]) {
+                weighted.push_back({value, weight});
+                totalWeight += weight;
+            }
+        }
+        sort(weighted.begin(), weighted.end());
+
+        double target = q * (double)totalWeight;
+        uint64_t cumulative = 0;
+        for (const auto& item : weighted) {
+            cumulative += item.second;
+            if ((double)cumulative >= target) {
+                return item.first;
+            }
+        }
+        return maxValue;
+    }
+
+    void clear() {
+        levels.assign(1, vector<double>());
+        count = 0;
+        minValue = maxValue = 0.0;
+    }
+
+    uint64_t getCount() const {
+        return count;
+    }
+
+    double getMin() const {
+        return minValue;
+    }
+
+    double getMax() const {
+        return maxValue;
+    }
+
+    // Number of values actually retained (memory footprint)
+    size_t getRetainedCount() const {
+        size_t retained = 0;
+        for (const auto& level : levels) {
+            retained += level.size();
+        }
+        return retained;
+    }
+};
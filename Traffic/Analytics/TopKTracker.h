@@ -0,0 +1,130 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+struct TopKEntry {
+    string key;
+    double weight;  // estimated total (e.g. total cost for a part)
+    double error;   // weight may be overestimated by at most this much
+    int count;
+};
+
+// Weighted Space-Saving heavy-hitter summary.
+// Keeps at most `capacity` counters; when a new key arrives and the table is
+// full, the lightest counter is evicted and its weight inherited as error.
+class TopKTracker {
+private:
+    struct Counter {
+        double weight;
+        double error;
+        int count;
+    };
+
+    size_t capacity;
+    unordered_map<string, Counter> counters;
+
+    // Upper bound on the weight of any key not tracked (0 until the table fills)
+    double floorWeight() const {
+        if (counters.size() < capacity) {
+            return 0.0;
+        }
+        double lightest = counters.begin()->second.weight;
+        for (const auto& entry : counters) {
+            lightest = min(lightest, entry.second.weight);
+        }
+        return lightest;
+    }
+
+    void trim() {
+        if (counters.size() <= capacity) {
+            return;
+        }
+        vector<TopKEntry> entries = top(capacity);
+        counters.clear();
+        for (const auto& e : entries) {
+            counters[e.key] = {e.weight, e.error, e.count};
+        }
+    }
+
+public:
+    TopKTracker(size_t capacity = 64) : capacity(capacity) {
+        if (capacity == 0) {
+            throw invalid_argument("[TopKTracker] Capacity must be positive");
+        }
+    }
+
+    void add(const string& key, double weight) {
+        auto it = counters.find(key);
+        if (it != counters.end()) {
+            it->second.weight += weight;
+            it->second.count++;
+            return;
+        }
+
+        if (counters.size() < capacity) {
+            counters[key] = {weight, 0.0, 1};
+            return;
+        }
+
+        auto lightest = min_element(counters.begin(), counters.end(),
+            [](const auto& a, const auto& b) { return a.second.weight < b.second.weight; });
+        double floor = lightest->second.weight;
+        int floorCount = lightest->second.count;
+        counters.erase(lightest);
+        counters[key] = {floor + weight, floor, floorCount + 1};
+    }
+
+    // A key missing from a full summary may still have had up to that
+    // summary's lightest weight evicted, so that floor is added to both its
+    // weight and its error (mergeable Space-Saving).
+    void merge(const TopKTracker& other) {
+        double thisFloor = floorWeight();
+        double otherFloor = other.floorWeight();
+
+        for (auto& [key, c] : counters) {
+            if (!other.counters.count(key)) {
+                c.weight += otherFloor;
+                c.error += otherFloor;
+            }
+        }
+        for (const auto& [key, c] : other.counters) {
+            auto it = counters.find(key);
+            if (it != counters.end()) {
+                it->second.weight += c.weight;
+                it->second.error += c.error;
+                it->second.count += c.count;
+            } else {
+                counters[key] = {c.weight + thisFloor, c.error + thisFloor, c.count};
+            }
+        }
+        trim();
+    }
+
+    // Heaviest k keys, heaviest first
+    vector<TopKEntry> top(size_t k) const {
+        vector<TopKEntry> entries;
+        entries.reserve(counters.size());
+        for (const auto& [key, c] : counters) {
+            entries.push_back({key, c.weight, c.error, c.count});
+        }
+        sort(entries.begin(), entries.end(),
+            [](const TopKEntry& a, const TopKEntry& b) { return a.weight > b.weight; });
+        if (entries.size() > k) {
+            entries.resize(k);
+        }
+        return entries;
+    }
+
+    void clear() {
+        counters.clear();
+    }
+
+    size_t size() const {
+        return counters.size();
+    }
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <iostream>
+#include <atomic>
 using namespace std;
 
 enum class BrakeType {
@@ -33,15 +34,35 @@ class Brake {
 private:
     string model;
     BrakeType type;
-    bool isEngaged;
-    int brakeForce;
+
+    // Force (0-100), engaged flag and emergency latch packed in one word so the
+    // real-time emergency path and the control thread can never interleave
+    // into a half-updated state.
+    static constexpr int FORCE_MASK = 0xFF;
+    static constexpr int ENGAGED = 1 << 8;
+    static constexpr int EMERGENCY = 1 << 9;
+    atomic<int> state;
+
+    // Control-thread update; refused while an emergency stop is latched
+    bool setState(int newState) {
+        int current = state.load(memory_order_acquire);
+        while (!(current & EMERGENCY)) {
+            if (state.compare_exchange_weak(current, newState, memory_order_acq_rel)) {
+                return true;
+            }
+        }
+        return false;
+    }
 
 public:
     Brake(string model, BrakeType type = BrakeType::HYDRAULIC) 
-        : model(model), type(type), isEngaged(false), brakeForce(0) {
+        : model(model), type(type), state(0) {
         cout << "[Brake] Brake system created: " << brakeTypeToString(this->type) << endl;
     }
 
+    Brake(const Brake& other)
+        : model(other.model), type(other.type), state(other.state.load()) {}
+
     ~Brake() {
         cout << "[Brake] " << this->model << " Brake has been destructured!" << endl;
     }
@@ -53,45 +74,68 @@ public:
             return;
         }
 
-        this->brakeForce = force;
-        this->isEngaged = true;
+        if (!setState(force | ENGAGED)) {
+            cout << "[Brake] " << this->model << " is held at full force by an emergency stop." << endl;
+            return;
+        }
         cout << "[Brake] " << this->model << " applied at " << force << "% force." << endl;
     }
 
     void release() {
         if (this->engaged()) {
-            this->brakeForce = 0;
-            this->isEngaged = false;
+            if (!setState(0)) {
+                cout << "[Brake] " << this->model << " is held by an emergency stop, cannot release." << endl;
+                return;
+            }
             cout << "[Brake] " << this->model << " has been RELEASED!" << endl;
         } else {
             cout << "[Brake] " << this->model << " is already released." << endl;
         }
     }
 
+    // Real-time path: a single atomic store, no I/O, allocation or locks.
+    // Safe to call from any thread; latches until acknowledgeEmergency().
+    void emergencyEngage() noexcept {
+        state.store(100 | ENGAGED | EMERGENCY, memory_order_release);
+    }
+
     void emergencyStop() {
-        apply(100);
+        emergencyEngage();
         cout << "[Brake] *** EMERGENCY BRAKE ACTIVATED for " << this->model << " ***" << endl;
     }
 
+    // Unlatch after the emergency has been handled; brakes stay engaged
+    void acknowledgeEmergency() {
+        state.fetch_and(~EMERGENCY, memory_order_acq_rel);
+    }
+
+    bool emergencyLatched() const noexcept {
+        return state.load(memory_order_acquire) & EMERGENCY;
+    }
+
     string getType() {
         return brakeTypeToString(this->type);
     }
 
+    BrakeType getBrakeType() const {
+        return this->type;
+    }
+
     string getModel() {
         return this->model;
     }
 
-    bool engaged() {
-        return this->isEngaged;
+    bool engaged() const {
+        return state.load(memory_order_acquire) & ENGAGED;
     }
 
-    int getForce() {
-        return this->brakeForce;
+    int getForce() const {
+        return state.load(memory_order_acquire) & FORCE_MASK;
     }
 
     string getStatus() {
         string status = engaged() ? "Engaged" : "Released";
         return "[Brake] " + model + ", " + brakeTypeToString(type) + 
-               " : Status = " + status + ", BrakeForce = " + to_string(brakeForce) + "%";
+               " : Status = " + status + ", BrakeForce = " + to_string(getForce()) + "%";
     }
 };
\ No newline at end of file
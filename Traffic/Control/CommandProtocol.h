@@ -0,0 +1,161 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+// Binary protocol of the fleet command server (host byte order, local only).
+//
+// Request frame:   u16 bodyLength, body
+//   body:          u32 requestID, u8 opcode, u8 idLength, trainID bytes, arguments
+//   TRAVEL:        i32 distance
+//   MAINTENANCE:   f64 cost, u8 partLength, part bytes, u8 dateLength, date bytes
+// Response:        u32 requestID, u8 status   (fixed 5 bytes)
+//
+// Clients may pipeline any number of requests without waiting; responses come
+// back in request order, batched into as few writes as possible.
+enum class CommandOpcode : uint8_t {
+    START = 1,
+    STOP = 2,
+    GRADUAL_STOP = 3,
+    EMERGENCY_STOP = 4,
+    TRAVEL = 5,
+    MAINTENANCE = 6
+};
+
+enum class CommandStatus : uint8_t {
+    OK = 0,
+    UNKNOWN_TRAIN = 1,
+    BAD_REQUEST = 2,
+    FAILED = 3
+};
+
+inline string commandStatusToString(CommandStatus status) {
+    switch (status) {
+        case CommandStatus::OK:
+            return "OK";
+        case CommandStatus::UNKNOWN_TRAIN:
+            return "Unknown train";
+        case CommandStatus::BAD_REQUEST:
+            return "Bad request";
+        case CommandStatus::FAILED:
+            return "Failed";
+        default:
+            return "Unknown";
+    }
+}
+
+struct CommandRequest {
+    uint32_t requestID = 0;
+    CommandOpcode opcode = CommandOpcode::START;
+    string trainID;
+    int32_t distance = 0;   // TRAVEL
+    double cost = 0.0;      // MAINTENANCE
+    string partName;        // MAINTENANCE
+    string date;            // MAINTENANCE
+};
+
+const size_t COMMAND_RESPONSE_SIZE = 5;
+
+class CommandCodec {
+private:
+    template <typename T>
+    static void put(vector<char>& out, T value) {
+        size_t at = out.size();
+        out.resize(at + sizeof(T));
+        memcpy(out.data() + at, &value, sizeof(T));
+    }
+
+    static void putShortString(vector<char>& out, const string& value) {
+        uint8_t length = (uint8_t)min<size_t>(value.size(), 255);
+        put(out, length);
+        out.insert(out.end(), value.begin(), value.begin() + length);
+    }
+
+    template <typename T>
+    static bool get(const char*& at, const char* end, T& value) {
+        if ((size_t)(end - at) < sizeof(T)) {
+            return false;
+        }
+        memcpy(&value, at, sizeof(T));
+        at += sizeof(T);
+        return true;
+    }
+
+    static bool getShortString(const char*& at, const char* end, string& value) {
+        uint8_t length;
+        if (!get(at, end, length) || (size_t)(end - at) < length) {
+            return false;
+        }
+        value.assign(at, length);
+        at += length;
+        return true;
+    }
+
+public:
+    static void encodeRequest(vector<char>& out, const CommandRequest& request) {
+        size_t lengthAt = out.size();
+        put(out, (uint16_t)0);  // patched below
+        put(out, request.requestID);
+        put(out, (uint8_t)request.opcode);
+        putShortString(out, request.trainID);
+        if (request.opcode == CommandOpcode::TRAVEL) {
+            put(out, request.distance);
+        } else if (request.opcode == CommandOpcode::MAINTENANCE) {
+            put(out, request.cost);
+            putShortString(out, request.partName);
+            putShortString(out, request.date);
+        }
+        uint16_t bodyLength = (uint16_t)(out.size() - lengthAt - sizeof(uint16_t));
+        memcpy(out.data() + lengthAt, &bodyLength, sizeof(bodyLength));
+    }
+
+    // Size of the complete frame at `data`, or 0 if more bytes are needed
+    static size_t frameSize(const char* data, size_t available) {
+        uint16_t bodyLength;
+        if (available < sizeof(bodyLength)) {
+            return 0;
+        }
+        memcpy(&bodyLength, data, sizeof(bodyLength));
+        size_t total = sizeof(bodyLength) + bodyLength;
+        return available >= total ? total : 0;
+    }
+
+    // Parses one complete frame; returns false if the body is malformed.
+    // requestID is filled in whenever the body is at least 4 bytes long.
+    static bool decodeRequest(const char* frame, size_t size, CommandRequest& request) {
+        const char* at = frame + sizeof(uint16_t);
+        const char* end = frame + size;
+        uint8_t opcode;
+        if (!get(at, end, request.requestID) || !get(at, end, opcode) ||
+            !getShortString(at, end, request.trainID)) {
+            return false;
+        }
+        if (opcode < (uint8_t)CommandOpcode::START || opcode > (uint8_t)CommandOpcode::MAINTENANCE) {
+            return false;
+        }
+        request.opcode = (CommandOpcode)opcode;
+        if (request.opcode == CommandOpcode::TRAVEL) {
+            return get(at, end, request.distance);
+        }
+        if (request.opcode == CommandOpcode::MAINTENANCE) {
+            return get(at, end, request.cost) &&
+                   getShortString(at, end, request.partName) &&
+                   getShortString(at, end, request.date);
+        }
+        return true;
+    }
+
+    static void encodeResponse(vector<char>& out, uint32_t requestID, CommandStatus status) {
+        put(out, requestID);
+        put(out, (uint8_t)status);
+    }
+
+    static void decodeResponse(const char* data, uint32_t& requestID, CommandStatus& status) {
+        memcpy(&requestID, data, sizeof(requestID));
+        status = (CommandStatus)(uint8_t)data[sizeof(requestID)];
+    }
+};
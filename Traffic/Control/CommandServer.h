@@ -0,0 +1,322 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <stdexcept>
+#include <iostream>
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "CommandProtocol.h"
+#include "../Fleet/Fleet.h"
+
+using namespace std;
+
+// Local fleet control server on a Unix domain socket (see CommandProtocol.h).
+// A single epoll loop owns every train, so it is the trains' control thread:
+// train methods are never called concurrently. Each readable connection has
+// all of its buffered requests decoded and executed as one batch, and their
+// responses go out in a single write. Emergency stops in a batch are engaged
+// before any other command of that batch runs.
+// A client that sends faster than it reads its responses is throttled: while
+// its unsent output is over MAX_PENDING_OUTPUT the connection is not read, so
+// the kernel socket buffers fill up and the client's writes block.
+class CommandServer {
+private:
+    struct Connection {
+        vector<char> input;
+        vector<char> output;
+        size_t outputSent = 0;
+        uint32_t events = 0;  // currently registered with epoll
+    };
+
+    static constexpr size_t MAX_PENDING_OUTPUT = 1 << 20;
+    static constexpr size_t MAX_BUFFERED_INPUT = 1 << 18;  // read per wakeup
+
+    Fleet& fleet;
+    string socketPath;
+    int listenFd;
+    int epollFd;
+    int wakeFd;
+    atomic<bool> stopping;
+    unordered_map<int, Connection> connections;
+    uint64_t commandsHandled;
+
+    static void setNonBlocking(int fd) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    CommandStatus execute(const CommandRequest& request) {
+        Train* train = fleet.findTrain(request.trainID);
+        if (!train) {
+            return CommandStatus::UNKNOWN_TRAIN;
+        }
+        try {
+            switch (request.opcode) {
+                case CommandOpcode::START:
+                    if (!train->start()) {
+                        return CommandStatus::FAILED;  // e.g. emergency stop in progress
+                    }
+                    break;
+                case CommandOpcode::STOP:
+                    train->stop();
+                    break;
+                case CommandOpcode::GRADUAL_STOP:
+                    train->gradualStop();
+                    break;
+                case CommandOpcode::EMERGENCY_STOP:
+                    train->emergencyStop();
+                    break;
+                case CommandOpcode::TRAVEL:
+                    if (request.distance <= 0) {
+                        return CommandStatus::BAD_REQUEST;
+                    }
+                    if (!train->travel(request.distance)) {
+                        return CommandStatus::FAILED;
+                    }
+                    break;
+                case CommandOpcode::MAINTENANCE:
+                    train->performMaintenance(request.partName, request.cost, request.date);
+                    break;
+            }
+        } catch (const exception&) {
+            return CommandStatus::FAILED;  // e.g. invalid maintenance record
+        }
+        return CommandStatus::OK;
+    }
+
+    void acceptClients() {
+        while (true) {
+            int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK);
+            if (fd < 0) {
+                return;  // EAGAIN: no more pending connections
+            }
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLRDHUP;
+            event.data.fd = fd;
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+                cout << "[CommandServer] Cannot watch client connection, closing it" << endl;
+                close(fd);
+                continue;
+            }
+            connections[fd].events = event.events;
+        }
+    }
+
+    void closeClient(int fd) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(fd);
+    }
+
+    // Decodes every complete frame in the input buffer and runs them as a batch
+    void processInput(Connection& connection) {
+        vector<CommandRequest> batch;
+        vector<bool> valid;
+        size_t consumed = 0;
+        while (true) {
+            size_t size = CommandCodec::frameSize(connection.input.data() + consumed,
+                                                  connection.input.size() - consumed);
+            if (size == 0) {
+                break;
+            }
+            CommandRequest request;
+            valid.push_back(CommandCodec::decodeRequest(connection.input.data() + consumed, size, request));
+            batch.push_back(move(request));
+            consumed += size;
+        }
+        connection.input.erase(connection.input.begin(), connection.input.begin() + consumed);
+
+        // Emergency stops jump ahead of the normal commands in the same batch
+        for (size_t i = 0; i < batch.size(); i++) {
+            if (valid[i] && batch[i].opcode == CommandOpcode::EMERGENCY_STOP) {
+                if (Train* train = fleet.findTrain(batch[i].trainID)) {
+                    train->requestEmergencyStop();
+                }
+            }
+        }
+
+        for (size_t i = 0; i < batch.size(); i++) {
+            CommandStatus status = valid[i] ? execute(batch[i]) : CommandStatus::BAD_REQUEST;
+            CommandCodec::encodeResponse(connection.output, batch[i].requestID, status);
+        }
+        commandsHandled += batch.size();
+    }
+
+    // Returns false if the connection has to be closed
+    bool flushOutput(int fd, Connection& connection) {
+        while (connection.outputSent < connection.output.size()) {
+            ssize_t sent = send(fd, connection.output.data() + connection.outputSent,
+                                connection.output.size() - connection.outputSent, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                return false;
+            }
+            connection.outputSent += (size_t)sent;
+        }
+
+        size_t pending = connection.output.size() - connection.outputSent;
+        if (pending == 0) {
+            connection.output.clear();
+            connection.outputSent = 0;
+        }
+        // Over the cap only writability is watched (EPOLLRDHUP is level
+        // triggered too, so it is dropped with EPOLLIN)
+        uint32_t events = pending > MAX_PENDING_OUTPUT
+            ? (uint32_t)EPOLLOUT
+            : (uint32_t)(EPOLLIN | EPOLLRDHUP) | (pending ? (uint32_t)EPOLLOUT : 0u);
+        if (events == connection.events) {
+            return true;
+        }
+        epoll_event event{};
+        event.events = events;
+        event.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event) != 0) {
+            return false;
+        }
+        connection.events = events;
+        return true;
+    }
+
+    void handleClient(int fd, uint32_t events) {
+        auto it = connections.find(fd);
+        if (it == connections.end()) {
+            return;
+        }
+        Connection& connection = it->second;
+
+        if (events & EPOLLIN) {
+            char buffer[65536];
+            bool open = true;
+            // Bounded so a fast sender cannot grow the buffers without limit;
+            // anything left unread keeps the socket readable for next time
+            while (connection.input.size() < MAX_BUFFERED_INPUT) {
+                ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+                if (received > 0) {
+                    connection.input.insert(connection.input.end(), buffer, buffer + received);
+                    continue;
+                }
+                if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    open = false;
+                }
+                break;
+            }
+            processInput(connection);
+            if (!flushOutput(fd, connection) || !open) {
+                closeClient(fd);
+                return;
+            }
+        } else if (events & EPOLLOUT) {
+            if (!flushOutput(fd, connection)) {
+                closeClient(fd);
+                return;
+            }
+        }
+
+        if (events & (EPOLLHUP | EPOLLERR)) {
+            closeClient(fd);
+        }
+    }
+
+public:
+    CommandServer(Fleet& fleet, string socketPath)
+        : fleet(fleet), socketPath(socketPath), listenFd(-1), epollFd(-1), wakeFd(-1),
+          stopping(false), commandsHandled(0) {
+        sockaddr_un address{};
+        if (socketPath.size() >= sizeof(address.sun_path)) {
+            throw invalid_argument("[CommandServer] Socket path too long: " + socketPath);
+        }
+        address.sun_family = AF_UNIX;
+        memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+        listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        unlink(socketPath.c_str());
+        if (listenFd < 0 ||
+            bind(listenFd, (sockaddr*)&address, sizeof(address)) != 0 ||
+            listen(listenFd, 256) != 0) {
+            if (listenFd >= 0) {
+                close(listenFd);
+            }
+            throw runtime_error("[CommandServer] Cannot listen on " + socketPath);
+        }
+        setNonBlocking(listenFd);
+
+        epollFd = epoll_create1(0);
+        wakeFd = eventfd(0, EFD_NONBLOCK);
+        epoll_event listenEvent{};
+        listenEvent.events = EPOLLIN;
+        listenEvent.data.fd = listenFd;
+        epoll_event wakeEvent{};
+        wakeEvent.events = EPOLLIN;
+        wakeEvent.data.fd = wakeFd;
+        if (epollFd < 0 || wakeFd < 0 ||
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent) != 0 ||
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &wakeEvent) != 0) {
+            for (int fd : {wakeFd, epollFd, listenFd}) {
+                if (fd >= 0) {
+                    close(fd);
+                }
+            }
+            unlink(socketPath.c_str());
+            throw runtime_error("[CommandServer] Cannot set up the event loop");
+        }
+
+        cout << "[CommandServer] Listening on " << socketPath
+             << " for " << fleet.size() << " trains" << endl;
+    }
+
+    CommandServer(const CommandServer&) = delete;
+    CommandServer& operator=(const CommandServer&) = delete;
+
+    ~CommandServer() {
+        for (const auto& entry : connections) {
+            close(entry.first);
+        }
+        close(wakeFd);
+        close(epollFd);
+        close(listenFd);
+        unlink(socketPath.c_str());
+        cout << "[CommandServer] Shut down after " << commandsHandled << " commands" << endl;
+    }
+
+    // Blocks until requestStop() is called
+    void run() {
+        epoll_event events[128];
+        while (!stopping.load(memory_order_acquire)) {
+            int ready = epoll_wait(epollFd, events, 128, -1);
+            if (ready < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw runtime_error("[CommandServer] epoll_wait failed");
+            }
+            for (int i = 0; i < ready; i++) {
+                int fd = events[i].data.fd;
+                if (fd == listenFd) {
+                    acceptClients();
+                } else if (fd != wakeFd) {
+                    handleClient(fd, events[i].events);
+                }
+            }
+        }
+    }
+
+    // Safe from any thread
+    void requestStop() {
+        stopping.store(true, memory_order_release);
+        uint64_t one = 1;
+        ssize_t ignored = write(wakeFd, &one, sizeof(one));
+        (void)ignored;
+    }
+
+    uint64_t getCommandsHandled() const {
+        return commandsHandled;
+    }
+};
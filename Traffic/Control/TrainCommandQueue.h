@@ -0,0 +1,99 @@
+#pragma once
+#include <deque>
+#include <mutex>
+#include <string>
+#include "../Train/Train.h"
+
+using namespace std;
+
+enum class TrainCommandType {
+    START,
+    STOP,
+    GRADUAL_STOP,
+    TRAVEL
+};
+
+struct TrainCommand {
+    TrainCommandType type;
+    int distance = 0;  // TRAVEL only
+};
+
+// Commands for one train. Any thread may submit(); only the train's control
+// thread calls process(). Emergency stops bypass the queue entirely:
+// emergencyStop() engages the brakes immediately and, when the control thread
+// next runs process(), every queued normal command is discarded before the
+// emergency stop is completed.
+class TrainCommandQueue {
+private:
+    Train& train;
+    mutex lock;
+    deque<TrainCommand> pending;
+
+    void execute(const TrainCommand& command) {
+        switch (command.type) {
+            case TrainCommandType::START:
+                train.start();
+                break;
+            case TrainCommandType::STOP:
+                train.stop();
+                break;
+            case TrainCommandType::GRADUAL_STOP:
+                train.gradualStop();
+                break;
+            case TrainCommandType::TRAVEL:
+                train.travel(command.distance);
+                break;
+        }
+    }
+
+    bool handleEmergency() {
+        if (!train.isEmergencyPending()) {
+            return false;
+        }
+        {
+            lock_guard<mutex> guard(lock);
+            pending.clear();
+        }
+        train.emergencyStop();
+        return true;
+    }
+
+public:
+    TrainCommandQueue(Train& train) : train(train) {}
+
+    void submit(TrainCommand command) {
+        lock_guard<mutex> guard(lock);
+        pending.push_back(command);
+    }
+
+    // Real-time path; never allocates or blocks
+    void emergencyStop() noexcept {
+        train.requestEmergencyStop();
+    }
+
+    // Runs queued commands; returns true if an emergency stop was handled
+    bool process() {
+        if (handleEmergency()) {
+            return true;
+        }
+
+        deque<TrainCommand> batch;
+        {
+            lock_guard<mutex> guard(lock);
+            batch.swap(pending);
+        }
+        for (const auto& command : batch) {
+            // An emergency raised mid-batch pre-empts the rest of it
+            if (handleEmergency()) {
+                return true;
+            }
+            execute(command);
+        }
+        return false;
+    }
+
+    size_t getPendingCount() {
+        lock_guard<mutex> guard(lock);
+        return pending.size();
+    }
+};
@@ -0,0 +1,157 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include "../Train/Train.h"
+
+using namespace std;
+
+const int ENGINE_TYPE_COUNT = 4;
+
+// Rough physical constants for the energy model
+const double KW_PER_HP = 0.7457;
+const double TRAIN_TARE_KG = 30000.0;      // empty train
+const double PASSENGER_KG = 75.0;          // per seat of capacity (fully loaded)
+const double AVERAGE_TRACTION_LOAD = 0.6;  // share of rated power used while cruising
+const double REGEN_RECOVERY = 0.6;         // share of braking energy a regenerative brake returns
+
+struct EngineEnergyProfile {
+    double efficiency;   // source-to-wheel
+    double cruiseKmh;
+};
+
+inline EngineEnergyProfile engineEnergyProfile(EngineType type) {
+    switch (type) {
+        case EngineType::ELECTRIC:
+            return {0.90, 80.0};
+        case EngineType::DIESEL:
+            return {0.35, 70.0};
+        case EngineType::HYBRID:
+            return {0.55, 75.0};
+        case EngineType::MAGNETIC_LEVITATION:
+            return {0.80, 250.0};
+        default:
+            return {0.50, 60.0};
+    }
+}
+
+inline double trainMassKg(int capacity) {
+    return TRAIN_TARE_KG + capacity * PASSENGER_KG;
+}
+
+struct EnergyAccount {
+    double tractionKWh = 0.0;
+    double recoveredKWh = 0.0;
+    double distanceKm = 0.0;
+    int trips = 0;
+
+    double netKWh() const {
+        return tractionKWh - recoveredKWh;
+    }
+
+    void add(const EnergyAccount& other) {
+        tractionKWh += other.tractionKWh;
+        recoveredKWh += other.recoveredKWh;
+        distanceKm += other.distanceKm;
+        trips += other.trips;
+    }
+};
+
+// Energy used for traction and recovered by regenerative braking, kept per
+// train and per engine type. Fed either trip by trip (recordTrip) or in bulk
+// by FleetEnergyModel every simulation tick (credit).
+class EnergyLedger {
+private:
+    vector<string> trainIDs;
+    vector<EngineType> trainTypes;
+    vector<EnergyAccount> trainAccounts;
+    unordered_map<string, size_t> indexByID;
+    EnergyAccount typeAccounts[ENGINE_TYPE_COUNT];
+
+public:
+    // Returns the train's account index (stable, usable with credit())
+    size_t registerTrain(const Train& train) {
+        auto it = indexByID.find(train.getID());
+        if (it != indexByID.end()) {
+            return it->second;
+        }
+        size_t index = trainAccounts.size();
+        trainIDs.push_back(train.getID());
+        trainTypes.push_back(train.getEngineType());
+        trainAccounts.emplace_back();
+        indexByID[train.getID()] = index;
+        return index;
+    }
+
+    // One trip at cruise speed with `stops` brake applications from cruise.
+    // Every stop is followed by re-accelerating to cruise, so a regenerative
+    // brake can only win back part of the energy the stops themselves cost.
+    EnergyAccount recordTrip(const Train& train, double distanceKm, int stops = 1) {
+        if (distanceKm <= 0) {
+            throw invalid_argument("[EnergyLedger] Trip distance must be positive");
+        }
+        if (stops < 0) {
+            throw invalid_argument("[EnergyLedger] Stop count cannot be negative");
+        }
+        EngineEnergyProfile profile = engineEnergyProfile(train.getEngineType());
+        double hours = distanceKm / profile.cruiseKmh;
+        double speedMs = profile.cruiseKmh / 3.6;
+        double kineticKWh = 0.5 * trainMassKg(train.getCapacity()) * speedMs * speedMs / 3.6e6;
+
+        EnergyAccount trip;
+        double cruiseKWh = train.getEnginePower() * KW_PER_HP * AVERAGE_TRACTION_LOAD * hours;
+        trip.tractionKWh = (cruiseKWh + stops * kineticKWh) / profile.efficiency;
+        if (train.getBrakeType() == BrakeType::REGENERATIVE) {
+            trip.recoveredKWh = stops * kineticKWh * REGEN_RECOVERY;
+        }
+        trip.distanceKm = distanceKm;
+        trip.trips = 1;
+
+        credit(registerTrain(train), trip);
+        return trip;
+    }
+
+    void credit(size_t index, const EnergyAccount& energy) {
+        trainAccounts[index].add(energy);
+        typeAccounts[(int)trainTypes[index]].add(energy);
+    }
+
+    const EnergyAccount& getTrainAccount(const string& trainID) const {
+        auto it = indexByID.find(trainID);
+        if (it == indexByID.end()) {
+            throw invalid_argument("[EnergyLedger] Unknown train: " + trainID);
+        }
+        return trainAccounts[it->second];
+    }
+
+    const EnergyAccount& getTypeAccount(EngineType type) const {
+        return typeAccounts[(int)type];
+    }
+
+    size_t getTrainCount() const {
+        return trainAccounts.size();
+    }
+
+    void showReport() const {
+        cout << "\n========================================" << endl;
+        cout << "  ENERGY REPORT (" << trainAccounts.size() << " trains)" << endl;
+        cout << "========================================" << endl;
+        EnergyAccount fleet;
+        for (int t = 0; t < ENGINE_TYPE_COUNT; t++) {
+            const EnergyAccount& account = typeAccounts[t];
+            fleet.add(account);
+            if (account.tractionKWh == 0.0 && account.recoveredKWh == 0.0) {
+                continue;
+            }
+            cout << "  " << engineTypeToString((EngineType)t) << ": "
+                 << fixed << setprecision(1) << account.tractionKWh << " kWh used, "
+                 << account.recoveredKWh << " kWh recovered, net "
+                 << account.netKWh() << " kWh" << endl;
+        }
+        cout << "  Fleet net: " << fixed << setprecision(1) << fleet.netKWh() << " kWh" << endl;
+        cout << "========================================\n" << endl;
+    }
+};
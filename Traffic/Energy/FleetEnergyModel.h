@@ -0,0 +1,112 @@
+#pragma once
+#include <vector>
+#include <stdexcept>
+#include "EnergyLedger.h"
+
+using namespace std;
+
+// Per-tick energy evaluation for a whole fleet.
+// Train parameters and state are kept as parallel arrays (structure of
+// arrays) and tick() is a single branch-free loop over them, so the compiler
+// can vectorize it. Accumulated energy is posted to an EnergyLedger with
+// flush(), e.g. once per simulated hour or at the end of the day. A trip is
+// counted each time setState() brings a moving train to rest.
+class FleetEnergyModel {
+private:
+    EnergyLedger& ledger;
+
+    // Static per-train parameters
+    vector<size_t> ledgerIndex;
+    vector<double> powerKW;
+    vector<double> inverseEfficiency;
+    vector<double> massKg;
+    vector<double> regenFactor;  // REGEN_RECOVERY for regenerative brakes, else 0
+
+    // State set by the simulation each tick
+    vector<double> throttle;     // 0..1 share of rated power
+    vector<double> speedMs;
+    vector<double> braking;      // 0..1 share of MAX_DECELERATION
+
+    // Accumulated since the last flush
+    vector<double> tractionKWh;
+    vector<double> recoveredKWh;
+    vector<double> distanceKm;
+    vector<int> completedTrips;
+
+    static constexpr double MAX_DECELERATION = 1.2;  // m/s^2 at full service braking
+
+public:
+    FleetEnergyModel(EnergyLedger& ledger) : ledger(ledger) {}
+
+    size_t addTrain(const Train& train) {
+        EngineEnergyProfile profile = engineEnergyProfile(train.getEngineType());
+        ledgerIndex.push_back(ledger.registerTrain(train));
+        powerKW.push_back(train.getEnginePower() * KW_PER_HP);
+        inverseEfficiency.push_back(1.0 / profile.efficiency);
+        massKg.push_back(trainMassKg(train.getCapacity()));
+        regenFactor.push_back(train.getBrakeType() == BrakeType::REGENERATIVE ? REGEN_RECOVERY : 0.0);
+
+        throttle.push_back(0.0);
+        speedMs.push_back(0.0);
+        braking.push_back(0.0);
+        tractionKWh.push_back(0.0);
+        recoveredKWh.push_back(0.0);
+        distanceKm.push_back(0.0);
+        completedTrips.push_back(0);
+        return ledgerIndex.size() - 1;
+    }
+
+    void setState(size_t train, double throttleLevel, double speed, double brakeLevel) {
+        if (train >= ledgerIndex.size()) {
+            throw out_of_range("[FleetEnergyModel] Unknown train index");
+        }
+        if (speedMs[train] > 0.0 && speed <= 0.0) {
+            completedTrips[train]++;
+        }
+        throttle[train] = throttleLevel;
+        speedMs[train] = speed;
+        braking[train] = brakeLevel;
+    }
+
+    void tick(double dtSeconds) {
+        const size_t n = ledgerIndex.size();
+        const double hours = dtSeconds / 3600.0;
+        const double jouleToKWh = 1.0 / 3.6e6;
+
+        const double* power = powerKW.data();
+        const double* invEff = inverseEfficiency.data();
+        const double* mass = massKg.data();
+        const double* regen = regenFactor.data();
+        const double* thr = throttle.data();
+        const double* v = speedMs.data();
+        const double* brk = braking.data();
+        double* traction = tractionKWh.data();
+        double* recovered = recoveredKWh.data();
+        double* distance = distanceKm.data();
+
+        for (size_t i = 0; i < n; i++) {
+            traction[i] += power[i] * thr[i] * hours * invEff[i];
+            // Braking power = m * a * v; a regenerative brake returns part of it
+            recovered[i] += regen[i] * mass[i] * brk[i] * MAX_DECELERATION * v[i] * dtSeconds * jouleToKWh;
+            distance[i] += v[i] * dtSeconds / 1000.0;
+        }
+    }
+
+    // Post accumulated energy to the ledger and reset the accumulators
+    void flush() {
+        for (size_t i = 0; i < ledgerIndex.size(); i++) {
+            EnergyAccount energy;
+            energy.tractionKWh = tractionKWh[i];
+            energy.recoveredKWh = recoveredKWh[i];
+            energy.distanceKm = distanceKm[i];
+            energy.trips = completedTrips[i];
+            ledger.credit(ledgerIndex[i], energy);
+            tractionKWh[i] = recoveredKWh[i] = distanceKm[i] = 0.0;
+            completedTrips[i] = 0;
+        }
+    }
+
+    size_t size() const {
+        return ledgerIndex.size();
+    }
+};
@@ -76,11 +76,15 @@ public:
         return engineTypeToString(this->type);
     }
 
-    int getPower() {
+    EngineType getEngineType() const {
+        return this->type;
+    }
+
+    int getPower() const {
         return this->power;
     }
 
-    bool running() {
+    bool running() const {
         return this->isRunning;
     }
 
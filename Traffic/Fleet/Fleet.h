@@ -0,0 +1,93 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <stdexcept>
+#include "../Train/Train.h"
+#include "../Analytics/CostAnalytics.h"
+
+using namespace std;
+
+// A maintenance search hit: the record stays in its train's log
+struct FleetMaintenanceMatch {
+    const Train* train;
+    uint32_t position;  // index into train->getMaintenanceLog().getRecords()
+
+    const MaintenanceRecord& record() const {
+        return train->getMaintenanceLog().getRecords()[position];
+    }
+};
+
+// Registry of the trains in service. Trains are owned elsewhere (Aggregation),
+// the fleet only keeps pointers and an ID lookup table.
+class Fleet {
+private:
+    string name;
+    vector<Train*> trains;
+    unordered_map<string, Train*> trainsByID;
+
+public:
+    Fleet(string name = "Metro Fleet") : name(name) {}
+
+    void addTrain(Train& train) {
+        if (trainsByID.count(train.getID())) {
+            throw invalid_argument("[Fleet] Train T-" + train.getID() + " is already registered");
+        }
+        trains.push_back(&train);
+        trainsByID[train.getID()] = &train;
+        cout << "[Fleet] Train T-" << train.getID() << " joined " << name << endl;
+    }
+
+    // nullptr when the ID is unknown
+    Train* findTrain(const string& trainID) const {
+        auto it = trainsByID.find(trainID);
+        return it == trainsByID.end() ? nullptr : it->second;
+    }
+
+    const vector<Train*>& getTrains() const {
+        return trains;
+    }
+
+    size_t size() const {
+        return trains.size();
+    }
+
+    string getName() const {
+        return name;
+    }
+
+    // Fleet-wide cost quantiles / top parts from the per-train summaries
+    CostAnalytics getCostAnalytics() const {
+        CostAnalytics fleetAnalytics;
+        for (const Train* train : trains) {
+            fleetAnalytics.merge(train->getMaintenanceAnalytics());
+        }
+        return fleetAnalytics;
+    }
+
+    // Delta export for every train. `watermarks` maps train ID to the last
+    // exported sequence (missing = export everything) and is advanced in place.
+    // Trains without new changes are skipped without touching their records.
+    void exportDeltaSince(unordered_map<string, uint64_t>& watermarks, ostream& out,
+                          ExportFormat format = ExportFormat::TEXT) const {
+        for (const Train* train : trains) {
+            uint64_t& watermark = watermarks[train->getID()];
+            if (train->getMaintenanceLog().getWatermark() == watermark) {
+                continue;
+            }
+            watermark = train->exportMaintenanceSince(watermark, out, format);
+        }
+    }
+
+    // Full-text search over every train's maintenance log: (trainID, record)
+    vector<FleetMaintenanceMatch> searchMaintenance(const string& query) const {
+        vector<FleetMaintenanceMatch> result;
+        for (const Train* train : trains) {
+            for (uint32_t position : train->getMaintenanceLog().searchPositions(query)) {
+                result.push_back({train, position});
+            }
+        }
+        return result;
+    }
+};
@@ -0,0 +1,262 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include "Fleet.h"
+
+using namespace std;
+
+struct QueryAggregate {
+    long long count = 0;
+    double sum = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+
+    void add(double value) {
+        if (count == 0) {
+            min = max = value;
+        } else {
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+        count++;
+        sum += value;
+    }
+
+    void merge(const QueryAggregate& other) {
+        if (other.count == 0) {
+            return;
+        }
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+        count += other.count;
+        sum += other.sum;
+    }
+
+    double average() const {
+        return count == 0 ? 0.0 : sum / count;
+    }
+};
+
+// Filter / group-by / aggregate over every maintenance record in a fleet.
+// Work is split into chunks of records (not whole trains, so one busy train
+// does not serialize the query); each worker aggregates into its own table
+// and the tables are merged at the end.
+//
+// Group keys never allocate per record: train attributes are computed once
+// per chunk, record fields are looked up as string_views into the record.
+//
+//   auto costByEngine = FleetQuery()
+//       .where([](const Train& t, const MaintenanceRecord& r) { return r.getCost() > 100; })
+//       .groupBy(FleetQuery::byEngineType())
+//       .run(fleet);
+class FleetQuery {
+public:
+    using TrainFilter = function<bool(const Train&)>;
+    using RecordFilter = function<bool(const Train&, const MaintenanceRecord&)>;
+    using Measure = function<double(const Train&, const MaintenanceRecord&)>;
+
+    // Exactly one of the three is set (see the static factories below)
+    struct GroupKey {
+        function<string(const Train&)> perTrain;
+        function<string_view(const MaintenanceRecord&)> perField;  // must view into the record
+        function<string(const Train&, const MaintenanceRecord&)> perRecord;
+    };
+
+private:
+    TrainFilter trainFilter;
+    RecordFilter recordFilter;
+    GroupKey groupKey;
+    Measure measure;
+    unsigned threadCount;
+
+    static constexpr size_t CHUNK_SIZE = 16384;
+
+    struct Chunk {
+        const Train* train;
+        size_t begin;
+        size_t end;
+    };
+
+    // Transparent hash so string_view keys are looked up without a copy
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(string_view key) const {
+            return hash<string_view>()(key);
+        }
+    };
+
+    using Table = unordered_map<string, QueryAggregate, KeyHash, equal_to<>>;
+
+    static QueryAggregate& slot(Table& table, string_view key) {
+        auto it = table.find(key);
+        if (it == table.end()) {
+            it = table.emplace(string(key), QueryAggregate()).first;
+        }
+        return it->second;
+    }
+
+    void runChunk(const Chunk& chunk, Table& table) const {
+        const Train& train = *chunk.train;
+        const vector<MaintenanceRecord>& records = train.getMaintenanceLog().getRecords();
+
+        // Train-level (or no) grouping: one key per chunk, its table entry
+        // looked up when the first record passes the filter
+        bool perChunk = !groupKey.perField && !groupKey.perRecord;
+        string chunkKey = groupKey.perTrain ? groupKey.perTrain(train) : "All";
+        QueryAggregate* chunkSlot = nullptr;
+
+        for (size_t i = chunk.begin; i < chunk.end; i++) {
+            const MaintenanceRecord& record = records[i];
+            if (recordFilter && !recordFilter(train, record)) {
+                continue;
+            }
+            double value = measure ? measure(train, record) : record.getCost();
+            if (perChunk) {
+                if (!chunkSlot) {
+                    chunkSlot = &slot(table, chunkKey);
+                }
+                chunkSlot->add(value);
+            } else if (groupKey.perField) {
+                slot(table, groupKey.perField(record)).add(value);
+            } else {
+                slot(table, groupKey.perRecord(train, record)).add(value);
+            }
+        }
+    }
+
+public:
+    FleetQuery() : threadCount(thread::hardware_concurrency()) {
+        if (threadCount == 0) {
+            threadCount = 1;
+        }
+    }
+
+    FleetQuery& whereTrain(TrainFilter filter) {
+        trainFilter = filter;
+        return *this;
+    }
+
+    FleetQuery& where(RecordFilter filter) {
+        recordFilter = filter;
+        return *this;
+    }
+
+    FleetQuery& groupBy(GroupKey key) {
+        groupKey = key;
+        return *this;
+    }
+
+    // Value to aggregate per record; defaults to the record cost
+    FleetQuery& aggregate(Measure value) {
+        measure = value;
+        return *this;
+    }
+
+    FleetQuery& withThreads(unsigned threads) {
+        threadCount = max(1u, threads);
+        return *this;
+    }
+
+    map<string, QueryAggregate> run(const Fleet& fleet) const {
+        vector<Chunk> chunks;
+        for (const Train* train : fleet.getTrains()) {
+            if (trainFilter && !trainFilter(*train)) {
+                continue;
+            }
+            size_t recordCount = train->getMaintenanceLog().getRecords().size();
+            for (size_t begin = 0; begin < recordCount; begin += CHUNK_SIZE) {
+                chunks.push_back({train, begin, min(begin + CHUNK_SIZE, recordCount)});
+            }
+        }
+
+        unsigned workers = (unsigned)min<size_t>(threadCount, max<size_t>(1, chunks.size()));
+        vector<Table> partials(workers);
+        atomic<size_t> nextChunk(0);
+
+        auto work = [&](unsigned worker) {
+            size_t index;
+            while ((index = nextChunk.fetch_add(1)) < chunks.size()) {
+                runChunk(chunks[index], partials[worker]);
+            }
+        };
+
+        if (workers == 1) {
+            work(0);
+        } else {
+            vector<thread> pool;
+            for (unsigned w = 0; w < workers; w++) {
+                pool.emplace_back(work, w);
+            }
+            for (auto& t : pool) {
+                t.join();
+            }
+        }
+
+        map<string, QueryAggregate> result;
+        for (const auto& partial : partials) {
+            for (const auto& [key, agg] : partial) {
+                result[key].merge(agg);
+            }
+        }
+        return result;
+    }
+
+    // Common group keys (joins to train attributes included)
+    static GroupKey byPart() {
+        return {nullptr, [](const MaintenanceRecord& r) { return string_view(r.getPartName()); }, nullptr};
+    }
+
+    static GroupKey byTechnician() {
+        return {nullptr, [](const MaintenanceRecord& r) { return string_view(r.getTechnician()); }, nullptr};
+    }
+
+    static GroupKey byTrain() {
+        return byTrainAttribute([](const Train& t) { return t.getID(); });
+    }
+
+    static GroupKey byEngineType() {
+        return byTrainAttribute([](const Train& t) { return engineTypeToString(t.getEngineType()); });
+    }
+
+    static GroupKey byBrakeType() {
+        return byTrainAttribute([](const Train& t) { return brakeTypeToString(t.getBrakeType()); });
+    }
+
+    // Custom keys: per train (cheap), or per record (built for every record)
+    static GroupKey byTrainAttribute(function<string(const Train&)> key) {
+        return {key, nullptr, nullptr};
+    }
+
+    static GroupKey byRecord(function<string(const Train&, const MaintenanceRecord&)> key) {
+        return {nullptr, nullptr, key};
+    }
+
+    static void showResults(const string& title, const map<string, QueryAggregate>& results) {
+        cout << "\n========================================" << endl;
+        cout << "  " << title << endl;
+        cout << "========================================" << endl;
+        if (results.empty()) {
+            cout << "  No matching records." << endl;
+        }
+        for (const auto& [key, agg] : results) {
+            cout << "  " << key << ": " << agg.count << " records, total $"
+                 << fixed << setprecision(2) << agg.sum
+                 << ", avg $" << agg.average()
+                 << ", max $" << agg.max << endl;
+        }
+        cout << "========================================\n" << endl;
+    }
+};
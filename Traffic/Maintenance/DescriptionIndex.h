@@ -0,0 +1,232 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <cctype>
+#include <cstdint>
+#include <algorithm>
+#include <queue>
+#include <functional>
+#include <utility>
+#include "MaintenanceRecord.h"
+
+using namespace std;
+
+// Inverted index over maintenance record text (description + part name).
+// Each term maps to a posting list of record positions, stored as
+// varint-encoded deltas so long lists stay a byte or two per entry.
+// Positions must be added in increasing order (MaintenanceLog appends only).
+//
+// Query syntax for search():
+//   "worn brake"         -> records containing both terms (AND)
+//   "worn OR leak"       -> records containing either term
+//   "brak*"              -> any term starting with "brak"
+class DescriptionIndex {
+private:
+    struct PostingList {
+        vector<uint8_t> bytes;
+        uint32_t last = 0;
+        uint32_t count = 0;
+    };
+
+    map<string, PostingList> terms;  // ordered so prefix queries are a range scan
+
+    static void appendVarint(vector<uint8_t>& out, uint32_t value) {
+        while (value >= 0x80) {
+            out.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back((uint8_t)value);
+    }
+
+    static vector<uint32_t> decode(const PostingList& list) {
+        vector<uint32_t> positions;
+        positions.reserve(list.count);
+        uint32_t current = 0;
+        size_t i = 0;
+        while (i < list.bytes.size()) {
+            uint32_t delta = 0;
+            int shift = 0;
+            uint8_t byte;
+            do {
+                byte = list.bytes[i++];
+                delta |= (uint32_t)(byte & 0x7F) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+            current += delta;
+            positions.push_back(current);
+        }
+        return positions;
+    }
+
+    void addTerm(const string& term, uint32_t position) {
+        PostingList& list = terms[term];
+        if (list.count > 0 && list.last == position) {
+            return;  // term repeated within the same record
+        }
+        appendVarint(list.bytes, list.count == 0 ? position : position - list.last);
+        list.last = position;
+        list.count++;
+    }
+
+    // Union of k sorted lists: k-way merge over a min-heap of list heads,
+    // O(N log k) for N postings in total
+    static vector<uint32_t> uniteAll(const vector<vector<uint32_t>>& lists) {
+        using Head = pair<uint32_t, size_t>;  // (position, list index)
+        priority_queue<Head, vector<Head>, greater<Head>> heads;
+        vector<size_t> next(lists.size(), 0);
+        size_t total = 0;
+        for (size_t i = 0; i < lists.size(); i++) {
+            total += lists[i].size();
+            if (!lists[i].empty()) {
+                heads.push({lists[i][0], i});
+                next[i] = 1;
+            }
+        }
+
+        vector<uint32_t> out;
+        out.reserve(total);
+        while (!heads.empty()) {
+            auto [position, i] = heads.top();
+            heads.pop();
+            if (out.empty() || out.back() != position) {
+                out.push_back(position);
+            }
+            if (next[i] < lists[i].size()) {
+                heads.push({lists[i][next[i]++], i});
+            }
+        }
+        return out;
+    }
+
+    static vector<uint32_t> intersect(const vector<uint32_t>& a, const vector<uint32_t>& b) {
+        vector<uint32_t> out;
+        set_intersection(a.begin(), a.end(), b.begin(), b.end(), back_inserter(out));
+        return out;
+    }
+
+    // Postings for one query term; a trailing '*' expands to every matching term
+    vector<uint32_t> lookup(const string& term) const {
+        if (!term.empty() && term.back() == '*') {
+            return searchPrefix(term.substr(0, term.size() - 1));
+        }
+        auto it = terms.find(term);
+        return it == terms.end() ? vector<uint32_t>() : decode(it->second);
+    }
+
+public:
+    static vector<string> tokenize(const string& text) {
+        vector<string> tokens;
+        string current;
+        for (char ch : text) {
+            if (isalnum((unsigned char)ch)) {
+                current += (char)tolower((unsigned char)ch);
+            } else if (!current.empty()) {
+                tokens.push_back(current);
+                current.clear();
+            }
+        }
+        if (!current.empty()) {
+            tokens.push_back(current);
+        }
+        return tokens;
+    }
+
+    void add(uint32_t position, const MaintenanceRecord& record) {
+        for (const auto& token : tokenize(record.getDescription())) {
+            addTerm(token, position);
+        }
+        for (const auto& token : tokenize(record.getPartName())) {
+            addTerm(token, position);
+        }
+    }
+
+    // Records containing every term
+    vector<uint32_t> searchAll(const vector<string>& queryTerms) const {
+        if (queryTerms.empty()) {
+            return {};
+        }
+        vector<vector<uint32_t>> lists;
+        for (const auto& term : queryTerms) {
+            lists.push_back(lookup(term));
+            if (lists.back().empty()) {
+                return {};
+            }
+        }
+        // Intersect shortest lists first to keep intermediates small
+        sort(lists.begin(), lists.end(),
+            [](const auto& a, const auto& b) { return a.size() < b.size(); });
+        vector<uint32_t> result = lists[0];
+        for (size_t i = 1; i < lists.size() && !result.empty(); i++) {
+            result = intersect(result, lists[i]);
+        }
+        return result;
+    }
+
+    // Records containing at least one term
+    vector<uint32_t> searchAny(const vector<string>& queryTerms) const {
+        vector<vector<uint32_t>> lists;
+        for (const auto& term : queryTerms) {
+            lists.push_back(lookup(term));
+        }
+        return uniteAll(lists);
+    }
+
+    vector<uint32_t> searchPrefix(const string& prefix) const {
+        vector<vector<uint32_t>> lists;
+        for (auto it = terms.lower_bound(prefix);
+             it != terms.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+            lists.push_back(decode(it->second));
+        }
+        return uniteAll(lists);
+    }
+
+    vector<uint32_t> search(const string& query) const {
+        // Groups are separated by the OR keyword; terms inside a group are ANDed
+        vector<vector<uint32_t>> groupResults;
+        vector<string> group;
+        string word;
+        auto flushGroup = [&]() {
+            groupResults.push_back(searchAll(group));
+            group.clear();
+        };
+        for (size_t i = 0; i <= query.size(); i++) {
+            char ch = i < query.size() ? query[i] : ' ';
+            if (!isspace((unsigned char)ch)) {
+                word += ch;
+                continue;
+            }
+            if (word.empty()) {
+                continue;
+            }
+            if (word == "OR") {
+                flushGroup();
+            } else {
+                vector<string> tokens = tokenize(word);
+                if (!tokens.empty() && word.back() == '*') {
+                    tokens.back() += '*';
+                }
+                group.insert(group.end(), tokens.begin(), tokens.end());
+            }
+            word.clear();
+        }
+        flushGroup();
+        return uniteAll(groupResults);
+    }
+
+    void clear() {
+        terms.clear();
+    }
+
+    size_t getTermCount() const {
+        return terms.size();
+    }
+
+    size_t getPostingBytes() const {
+        size_t total = 0;
+        for (const auto& entry : terms) {
+            total += entry.second.bytes.size();
+        }
+        return total;
+    }
+};
@@ -4,26 +4,47 @@
 #include <string>
 #include <iomanip>
 #include <stdexcept>
+#include <algorithm>
+#include <cstdint>
 #include "MaintenanceRecord.h"
+#include "DescriptionIndex.h"
+#include "../Analytics/CostAnalytics.h"
 
 
 using namespace std;
+
+enum class ExportFormat {
+    TEXT,
+    BINARY
+};
+
 class MaintenanceLog {
 private:
     vector<MaintenanceRecord> records;  // Aggregation - stores copies
     string trainID;
     double totalCost;
     int nextRecordID;
+    // Change tracking for delta exports. Unlike nextRecordID, sequence
+    // numbers never restart, so a watermark stays meaningful across clears.
+    uint64_t nextSequence;
+    vector<uint64_t> recordSequences;   // parallel to records, increasing
+    uint64_t lastClearSequence;         // 0 = never cleared
+    CostAnalytics analytics;            // Streaming cost quantiles / top parts
+    DescriptionIndex textIndex;         // Full-text index over descriptions
 
 public:
     MaintenanceLog(string trainID = "Unknown") 
-        : trainID(trainID), totalCost(0.0), nextRecordID(1) {
+        : trainID(trainID), totalCost(0.0), nextRecordID(1),
+          nextSequence(1), lastClearSequence(0) {
         cout << "[MaintenanceLog] Maintenance log initialized for Train: " << trainID << endl;
     }
 
     void addRecord(const MaintenanceRecord& record) {
         records.push_back(record);  // Copies the record
+        recordSequences.push_back(nextSequence++);
         totalCost += record.getCost();
+        analytics.add(record);
+        textIndex.add(records.size() - 1, record);
         cout << "[MaintenanceLog] Record #" << nextRecordID 
              << " added for Train " << trainID 
              << ": " << record.getPartName() 
@@ -72,6 +93,14 @@ public:
         return trainID;
     }
 
+    const vector<MaintenanceRecord>& getRecords() const {
+        return records;
+    }
+
+    const CostAnalytics& getAnalytics() const {
+        return analytics;
+    }
+
     vector<MaintenanceRecord> getRecordsByPart(string partName) const {
         vector<MaintenanceRecord> result;
         for (const auto& record : records) {
@@ -92,6 +121,20 @@ public:
         return result;
     }
 
+    // Positions in getRecords() of the records matching `query`, ascending
+    vector<uint32_t> searchPositions(const string& query) const {
+        return textIndex.search(query);
+    }
+
+    // e.g. "worn OR leak", "brake fluid", "bear*" (see DescriptionIndex)
+    vector<MaintenanceRecord> searchDescriptions(const string& query) const {
+        vector<MaintenanceRecord> result;
+        for (uint32_t position : textIndex.search(query)) {
+            result.push_back(records[position]);
+        }
+        return result;
+    }
+
     vector<MaintenanceRecord> getRecentRecords(int count) const {
         vector<MaintenanceRecord> result;
         int start = max(0, (int)records.size() - count);
@@ -117,8 +160,12 @@ public:
 
     void clearLog() {
         records.clear();
+        recordSequences.clear();
+        lastClearSequence = nextSequence++;  // tombstone for delta exports
         totalCost = 0.0;
         nextRecordID = 1;
+        analytics.clear();
+        textIndex.clear();
         cout << "[MaintenanceLog] All records cleared for Train " << trainID << endl;
     }
 
@@ -138,6 +185,19 @@ public:
                 cout << "  Most Expensive: " << expensive.getPartName() 
                      << " ($" << fixed << setprecision(2) << expensive.getCost() << ")" << endl;
             } catch (...) {}
+
+            cout << "  Cost p50 / p95 / p99: $"
+                 << fixed << setprecision(2) << analytics.quantile(0.50)
+                 << " / $" << analytics.quantile(0.95)
+                 << " / $" << analytics.quantile(0.99) << endl;
+
+            vector<TopKEntry> topParts = analytics.getTopParts(3);
+            cout << "  Top Parts by Cost:" << endl;
+            for (const auto& part : topParts) {
+                cout << "    - " << part.key << ": $"
+                     << fixed << setprecision(2) << part.weight
+                     << " (" << part.count << " records)" << endl;
+            }
         }
         cout << "========================================\n" << endl;
     }
@@ -203,4 +263,95 @@ public:
         }
         cout << "=== END OF EXPORT ===\n" << endl;
     }
+
+    // Sequence number of the latest change (0 = no changes yet)
+    uint64_t getWatermark() const {
+        return nextSequence - 1;
+    }
+
+    // Emits every change after `watermark` and returns the new watermark to
+    // pass next time. A clear after the watermark is emitted as one CLEAR
+    // tombstone (earlier clears are implied by it), followed by the records
+    // added since. Text lines (RFC 4180: fields containing commas, quotes or
+    // line breaks are quoted, with inner quotes doubled):
+    //   trainID,seq,CLEAR
+    //   trainID,seq,ADD,date,part,cost,technician,description
+    // Binary entries (host byte order):
+    //   u8 type (1 = ADD, 2 = CLEAR), u64 seq, str trainID
+    //   ADD only: str date, str part, f64 cost, str technician, str description
+    //   where str = u32 length + bytes
+    // The stream's formatting flags and precision are left as they were.
+    uint64_t exportSince(uint64_t watermark, ostream& out,
+                         ExportFormat format = ExportFormat::TEXT) const {
+        if (watermark >= getWatermark()) {
+            return getWatermark();
+        }
+
+        if (lastClearSequence > watermark) {
+            if (format == ExportFormat::TEXT) {
+                out << csvField(trainID) << "," << lastClearSequence << ",CLEAR\n";
+            } else {
+                writeBinaryEntry(out, 2, lastClearSequence, nullptr);
+            }
+        }
+
+        ios_base::fmtflags flags = out.flags();
+        streamsize precision = out.precision();
+        size_t first = upper_bound(recordSequences.begin(), recordSequences.end(), watermark)
+                       - recordSequences.begin();
+        for (size_t i = first; i < records.size(); i++) {
+            const auto& r = records[i];
+            if (format == ExportFormat::TEXT) {
+                out << csvField(trainID) << "," << recordSequences[i] << ",ADD,"
+                    << csvField(r.getDate()) << "," << csvField(r.getPartName()) << ","
+                    << fixed << setprecision(2) << r.getCost() << ","
+                    << csvField(r.getTechnician()) << "," << csvField(r.getDescription()) << "\n";
+            } else {
+                writeBinaryEntry(out, 1, recordSequences[i], &r);
+            }
+        }
+        out.flags(flags);
+        out.precision(precision);
+        return getWatermark();
+    }
+
+private:
+    static string csvField(const string& value) {
+        if (value.find_first_of(",\"\r\n") == string::npos) {
+            return value;
+        }
+        string quoted = "\"";
+        for (char ch : value) {
+            if (ch == '"') {
+                quoted += '"';
+            }
+            quoted += ch;
+        }
+        quoted += '"';
+        return quoted;
+    }
+
+    static void writeBinaryString(ostream& out, const string& value) {
+        if (value.size() > UINT32_MAX) {
+            throw length_error("[MaintenanceLog] Field too long for binary export");
+        }
+        uint32_t length = (uint32_t)value.size();
+        out.write((const char*)&length, sizeof(length));
+        out.write(value.data(), length);
+    }
+
+    void writeBinaryEntry(ostream& out, uint8_t type, uint64_t sequence,
+                          const MaintenanceRecord* record) const {
+        out.write((const char*)&type, sizeof(type));
+        out.write((const char*)&sequence, sizeof(sequence));
+        writeBinaryString(out, trainID);
+        if (record) {
+            double cost = record->getCost();
+            writeBinaryString(out, record->getDate());
+            writeBinaryString(out, record->getPartName());
+            out.write((const char*)&cost, sizeof(cost));
+            writeBinaryString(out, record->getTechnician());
+            writeBinaryString(out, record->getDescription());
+        }
+    }
 };
\ No newline at end of file
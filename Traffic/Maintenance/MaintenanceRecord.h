@@ -37,7 +37,7 @@ public:
           description(""), technician("N/A") {}
 
     // Getters
-    string getPartName() const {
+    const string& getPartName() const {
         return partName;
     }
 
@@ -45,15 +45,15 @@ public:
         return cost;
     }
 
-    string getDate() const {
+    const string& getDate() const {
         return date;
     }
 
-    string getDescription() const {
+    const string& getDescription() const {
         return description;
     }
 
-    string getTechnician() const {
+    const string& getTechnician() const {
         return technician;
     }
 
@@ -0,0 +1,270 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <iostream>
+#include <thread>
+#include <cerrno>
+#include <csignal>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../Train/Train.h"
+
+using namespace std;
+
+// Consistent copy of one train's hot state, as seen by a reader process
+struct TrainStateSnapshot {
+    char trainID[32];
+    int32_t mileage;
+    int32_t brakeForce;
+    bool engineRunning;
+    bool brakeEngaged;
+    bool needsMaintenance;
+    uint64_t version;  // number of publishes to this slot
+    bool stale;        // writer died or stalled mid-update; fields may be torn
+};
+
+// Live train state in a POSIX shared-memory segment.
+// One writer process publishes, any number of local reader processes take
+// snapshots. Each slot is a seqlock: the writer makes the sequence odd,
+// writes the fields, then makes it even again; a reader retries if it saw an
+// odd sequence or the sequence changed under it. Reads are plain loads on the
+// mapped memory (no syscalls, no locks) and never block the writer. A slot
+// stuck at an odd sequence (writer killed mid-update) is reported as stale
+// instead of being retried forever.
+class FleetStateSegment {
+private:
+    static constexpr uint64_t MAGIC = 0x4D4554524F535432ULL;  // "METROST2"
+
+    // Odd-sequence retries before checking on the writer, and yielding
+    // retries allowed while it is alive but stalled
+    static constexpr uint32_t READ_SPIN_LIMIT = 1 << 14;
+    static constexpr uint32_t READ_YIELD_LIMIT = 1000;
+
+    // Fields are relaxed atomics so concurrent access is well-defined;
+    // ordering comes from the sequence fences.
+    struct alignas(64) Slot {
+        atomic<uint64_t> sequence;
+        atomic<char> trainID[32];
+        atomic<int32_t> mileage;
+        atomic<int32_t> brakeForce;
+        atomic<uint8_t> flags;
+    };
+
+    struct Header {
+        uint64_t magic;
+        uint32_t capacity;
+        atomic<uint32_t> trainCount;
+        int32_t writerPid;
+    };
+
+    static constexpr uint8_t ENGINE_RUNNING = 1;
+    static constexpr uint8_t BRAKE_ENGAGED = 2;
+    static constexpr uint8_t NEEDS_MAINTENANCE = 4;
+
+    string name;
+    bool writer;
+    uint32_t capacity;  // as validated against this process's mapping
+    size_t mappedSize;
+    void* mapping;
+    Header* header;
+    Slot* slots;
+
+    static size_t segmentSize(uint32_t capacity) {
+        return sizeof(Slot) + (size_t)capacity * sizeof(Slot);  // header padded to one slot
+    }
+
+    FleetStateSegment(string name, bool writer, uint32_t capacity, size_t mappedSize, void* mapping)
+        : name(name), writer(writer), capacity(capacity), mappedSize(mappedSize), mapping(mapping),
+          header((Header*)mapping), slots((Slot*)((char*)mapping + sizeof(Slot))) {}
+
+public:
+    // Writer side: creates (or replaces) the segment, e.g. name = "/metro_state".
+    // A replaced segment is unlinked, never resized: readers that still have
+    // the old one mapped keep reading the old object until they reopen.
+    static FleetStateSegment create(const string& name, uint32_t capacity) {
+        static_assert(sizeof(Header) <= sizeof(Slot), "header must fit in the first slot");
+        shm_unlink(name.c_str());
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) {
+            throw runtime_error("[FleetStateSegment] shm_open failed for " + name);
+        }
+        size_t size = segmentSize(capacity);
+        if (ftruncate(fd, (off_t)size) != 0) {
+            close(fd);
+            throw runtime_error("[FleetStateSegment] Cannot size segment " + name);
+        }
+        void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            throw runtime_error("[FleetStateSegment] mmap failed for " + name);
+        }
+
+        FleetStateSegment segment(name, true, capacity, size, mapping);
+        memset(mapping, 0, size);
+        segment.header->capacity = capacity;
+        segment.header->trainCount.store(0, memory_order_relaxed);
+        segment.header->writerPid = (int32_t)getpid();
+        atomic_thread_fence(memory_order_release);
+        segment.header->magic = MAGIC;
+        cout << "[FleetStateSegment] Segment " << name << " created for "
+             << capacity << " trains" << endl;
+        return segment;
+    }
+
+    // Reader side: maps an existing segment read-only
+    static FleetStateSegment open(const string& name) {
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            throw runtime_error("[FleetStateSegment] No segment named " + name);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(Slot)) {
+            close(fd);
+            throw runtime_error("[FleetStateSegment] Segment " + name + " is not initialized");
+        }
+        void* mapping = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            throw runtime_error("[FleetStateSegment] mmap failed for " + name);
+        }
+
+        const Header* header = (const Header*)mapping;
+        uint32_t capacity = header->capacity;
+        if (header->magic != MAGIC || segmentSize(capacity) > (size_t)info.st_size) {
+            munmap(mapping, (size_t)info.st_size);
+            throw runtime_error("[FleetStateSegment] Segment " + name + " has an unknown layout");
+        }
+        return FleetStateSegment(name, false, capacity, (size_t)info.st_size, mapping);
+    }
+
+    FleetStateSegment(FleetStateSegment&& other) noexcept
+        : name(move(other.name)), writer(other.writer), capacity(other.capacity), mappedSize(other.mappedSize),
+          mapping(other.mapping), header(other.header), slots(other.slots) {
+        other.mapping = nullptr;
+    }
+
+    FleetStateSegment(const FleetStateSegment&) = delete;
+    FleetStateSegment& operator=(const FleetStateSegment&) = delete;
+    FleetStateSegment& operator=(FleetStateSegment&&) = delete;
+
+    ~FleetStateSegment() {
+        if (mapping) {
+            munmap(mapping, mappedSize);
+        }
+    }
+
+    // Writer only. Slot indexes are assigned by the writer (e.g. fleet order);
+    // a slot keeps the train ID of its first publish.
+    void publish(uint32_t index, const Train& train) {
+        if (!writer) {
+            throw logic_error("[FleetStateSegment] Segment was opened read-only");
+        }
+        if (index >= capacity) {
+            throw out_of_range("[FleetStateSegment] Slot index out of range");
+        }
+
+        Slot& slot = slots[index];
+        uint64_t sequence = slot.sequence.load(memory_order_relaxed);
+        slot.sequence.store(sequence + 1, memory_order_relaxed);  // odd: write in progress
+        atomic_thread_fence(memory_order_release);
+
+        if (sequence == 0) {
+            string id = train.getID();
+            size_t length = min(id.size(), sizeof(slot.trainID) - 1);
+            for (size_t i = 0; i < length; i++) {
+                slot.trainID[i].store(id[i], memory_order_relaxed);  // rest is zeroed by create()
+            }
+        }
+        slot.mileage.store(train.getMileage(), memory_order_relaxed);
+        slot.brakeForce.store(train.getBrakeForce(), memory_order_relaxed);
+        uint8_t flags = (train.isEngineRunning() ? ENGINE_RUNNING : 0) |
+                        (train.isBrakeEngaged() ? BRAKE_ENGAGED : 0) |
+                        (train.requiresMaintenance() ? NEEDS_MAINTENANCE : 0);
+        slot.flags.store(flags, memory_order_relaxed);
+
+        slot.sequence.store(sequence + 2, memory_order_release);  // even: stable
+
+        uint32_t count = header->trainCount.load(memory_order_relaxed);
+        if (index >= count) {
+            header->trainCount.store(index + 1, memory_order_release);
+        }
+    }
+
+    // False if the writer process has exited (kill() with no signal only
+    // probes; EPERM means the process exists under another user)
+    bool isWriterAlive() const {
+        return kill((pid_t)header->writerPid, 0) == 0 || errno == EPERM;
+    }
+
+    // Lock-free consistent read; retries while the writer is mid-update
+    TrainStateSnapshot read(uint32_t index) const {
+        if (index >= capacity) {
+            throw out_of_range("[FleetStateSegment] Slot index out of range");
+        }
+
+        const Slot& slot = slots[index];
+        TrainStateSnapshot snapshot;
+        uint32_t oddSpins = 0;
+        uint32_t yields = 0;
+        while (true) {
+            uint64_t before = slot.sequence.load(memory_order_acquire);
+            bool stale = false;
+            if (before & 1) {
+                if (++oddSpins < READ_SPIN_LIMIT) {
+                    continue;
+                }
+                oddSpins = 0;
+                if (isWriterAlive() && ++yields < READ_YIELD_LIMIT) {
+                    this_thread::yield();
+                    continue;
+                }
+                stale = true;
+            }
+            for (size_t i = 0; i < sizeof(snapshot.trainID); i++) {
+                snapshot.trainID[i] = slot.trainID[i].load(memory_order_relaxed);
+            }
+            snapshot.mileage = slot.mileage.load(memory_order_relaxed);
+            snapshot.brakeForce = slot.brakeForce.load(memory_order_relaxed);
+            uint8_t flags = slot.flags.load(memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            if (stale || slot.sequence.load(memory_order_relaxed) == before) {
+                snapshot.engineRunning = flags & ENGINE_RUNNING;
+                snapshot.brakeEngaged = flags & BRAKE_ENGAGED;
+                snapshot.needsMaintenance = flags & NEEDS_MAINTENANCE;
+                snapshot.version = before / 2;
+                snapshot.stale = stale;
+                snapshot.trainID[sizeof(snapshot.trainID) - 1] = '\0';
+                return snapshot;
+            }
+        }
+    }
+
+    vector<TrainStateSnapshot> readAll() const {
+        vector<TrainStateSnapshot> result;
+        uint32_t count = getTrainCount();
+        result.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            result.push_back(read(i));
+        }
+        return result;
+    }
+
+    uint32_t getTrainCount() const {
+        return min(header->trainCount.load(memory_order_acquire), capacity);
+    }
+
+    uint32_t getCapacity() const {
+        return capacity;
+    }
+
+    // Writer only: removes the segment name (mappings stay valid until unmapped)
+    void unlink() {
+        shm_unlink(name.c_str());
+    }
+};
@@ -0,0 +1,274 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <bit>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+using namespace std;
+
+struct TelemetrySample {
+    int64_t timestamp;  // milliseconds
+    double value;
+};
+
+// Append-only block of samples compressed the way Facebook's Gorilla TSDB does:
+//   - timestamps as delta-of-delta with variable-length prefixes
+//     (a steady sampling rate costs 1 bit per sample)
+//   - values XORed with the previous value, storing only the meaningful bits
+//     (a value that did not change costs 1 bit)
+// The block also keeps count/min/max/sum so aggregate queries can skip
+// decoding blocks that lie entirely inside the query range.
+class TelemetryBlock {
+private:
+    vector<uint64_t> words;
+    uint64_t bitCount;
+
+    int64_t firstTimestamp;
+    int64_t lastTimestamp;
+    uint32_t count;
+    double minValue;
+    double maxValue;
+    double sum;
+
+    // Encoder state
+    int64_t lastDelta;
+    uint64_t lastValueBits;
+    int lastLeading;
+    int lastTrailing;
+
+    void writeBits(uint64_t value, int n) {
+        if (n == 0) {
+            return;
+        }
+        if (n < 64) {
+            value &= ((uint64_t)1 << n) - 1;
+        }
+        size_t wordIndex = bitCount / 64;
+        int freeBits = 64 - (int)(bitCount % 64);
+        if (wordIndex == words.size()) {
+            words.push_back(0);
+        }
+        if (n <= freeBits) {
+            words[wordIndex] |= value << (freeBits - n);
+        } else {
+            int overflow = n - freeBits;
+            words[wordIndex] |= value >> overflow;
+            words.push_back(value << (64 - overflow));
+        }
+        bitCount += n;
+    }
+
+    class BitReader {
+    private:
+        const vector<uint64_t>& words;
+        uint64_t position;
+
+    public:
+        BitReader(const vector<uint64_t>& words) : words(words), position(0) {}
+
+        uint64_t read(int n) {
+            if (n == 0) {
+                return 0;
+            }
+            size_t wordIndex = position / 64;
+            int used = (int)(position % 64);
+            int available = 64 - used;
+            uint64_t result;
+            if (n <= available) {
+                result = (words[wordIndex] << used) >> (64 - n);
+            } else {
+                int rest = n - available;
+                uint64_t high = words[wordIndex] & (((uint64_t)1 << available) - 1);
+                result = (high << rest) | (words[wordIndex + 1] >> (64 - rest));
+            }
+            position += n;
+            return result;
+        }
+
+        bool readBit() {
+            return read(1) == 1;
+        }
+    };
+
+    static int64_t signExtend(uint64_t value, int bits) {
+        uint64_t sign = (uint64_t)1 << (bits - 1);
+        return (int64_t)((value ^ sign) - sign);
+    }
+
+    void writeTimestamp(int64_t timestamp) {
+        int64_t delta = timestamp - lastTimestamp;
+        int64_t dod = delta - lastDelta;
+        if (dod == 0) {
+            writeBits(0b0, 1);
+        } else if (dod >= -64 && dod <= 63) {
+            writeBits(0b10, 2);
+            writeBits((uint64_t)dod, 7);
+        } else if (dod >= -256 && dod <= 255) {
+            writeBits(0b110, 3);
+            writeBits((uint64_t)dod, 9);
+        } else if (dod >= -2048 && dod <= 2047) {
+            writeBits(0b1110, 4);
+            writeBits((uint64_t)dod, 12);
+        } else {
+            writeBits(0b1111, 4);
+            writeBits((uint64_t)dod, 64);
+        }
+        lastDelta = delta;
+    }
+
+    void writeValue(double value) {
+        uint64_t bits = bit_cast<uint64_t>(value);
+        uint64_t x = bits ^ lastValueBits;
+        lastValueBits = bits;
+        if (x == 0) {
+            writeBits(0b0, 1);
+            return;
+        }
+        writeBits(0b1, 1);
+
+        int leading = min(countl_zero(x), 31);
+        int trailing = countr_zero(x);
+        if (lastLeading >= 0 && leading >= lastLeading && trailing >= lastTrailing) {
+            // Fits inside the previous meaningful-bit window
+            writeBits(0b0, 1);
+            writeBits(x >> lastTrailing, 64 - lastLeading - lastTrailing);
+            return;
+        }
+
+        int significant = 64 - leading - trailing;
+        writeBits(0b1, 1);
+        writeBits((uint64_t)leading, 5);
+        writeBits((uint64_t)(significant & 63), 6);  // 64 is stored as 0
+        writeBits(x >> trailing, significant);
+        lastLeading = leading;
+        lastTrailing = trailing;
+    }
+
+public:
+    TelemetryBlock()
+        : bitCount(0), firstTimestamp(0), lastTimestamp(0), count(0),
+          minValue(0.0), maxValue(0.0), sum(0.0),
+          lastDelta(0), lastValueBits(0), lastLeading(-1), lastTrailing(0) {}
+
+    // Timestamps must not go backwards within a block
+    void append(int64_t timestamp, double value) {
+        if (count == 0) {
+            firstTimestamp = lastTimestamp = timestamp;
+            writeBits((uint64_t)timestamp, 64);
+            writeBits(bit_cast<uint64_t>(value), 64);
+            lastValueBits = bit_cast<uint64_t>(value);
+            minValue = maxValue = value;
+        } else {
+            writeTimestamp(timestamp);
+            writeValue(value);
+            lastTimestamp = timestamp;
+            minValue = min(minValue, value);
+            maxValue = max(maxValue, value);
+        }
+        sum += value;
+        count++;
+    }
+
+    vector<TelemetrySample> decode() const {
+        vector<TelemetrySample> samples;
+        if (count == 0) {
+            return samples;
+        }
+        samples.reserve(count);
+
+        BitReader reader(words);
+        int64_t timestamp = (int64_t)reader.read(64);
+        uint64_t valueBits = reader.read(64);
+        samples.push_back({timestamp, bit_cast<double>(valueBits)});
+
+        int64_t delta = 0;
+        int leading = 0;
+        int trailing = 0;
+        for (uint32_t i = 1; i < count; i++) {
+            int64_t dod;
+            if (!reader.readBit()) {
+                dod = 0;
+            } else if (!reader.readBit()) {
+                dod = signExtend(reader.read(7), 7);
+            } else if (!reader.readBit()) {
+                dod = signExtend(reader.read(9), 9);
+            } else if (!reader.readBit()) {
+                dod = signExtend(reader.read(12), 12);
+            } else {
+                dod = (int64_t)reader.read(64);
+            }
+            delta += dod;
+            timestamp += delta;
+
+            if (reader.readBit()) {
+                if (reader.readBit()) {
+                    leading = (int)reader.read(5);
+                    int significant = (int)reader.read(6);
+                    if (significant == 0) {
+                        significant = 64;
+                    }
+                    trailing = 64 - leading - significant;
+                }
+                int significant = 64 - leading - trailing;
+                valueBits ^= reader.read(significant) << trailing;
+            }
+            samples.push_back({timestamp, bit_cast<double>(valueBits)});
+        }
+        return samples;
+    }
+
+    // Sealed blocks are spilled as: header, bit count, words
+    void writeTo(ostream& out) const {
+        out.write((const char*)&firstTimestamp, sizeof(firstTimestamp));
+        out.write((const char*)&lastTimestamp, sizeof(lastTimestamp));
+        out.write((const char*)&count, sizeof(count));
+        out.write((const char*)&minValue, sizeof(minValue));
+        out.write((const char*)&maxValue, sizeof(maxValue));
+        out.write((const char*)&sum, sizeof(sum));
+        out.write((const char*)&bitCount, sizeof(bitCount));
+        out.write((const char*)words.data(), words.size() * sizeof(uint64_t));
+    }
+
+    static TelemetryBlock readFrom(istream& in) {
+        TelemetryBlock block;
+        in.read((char*)&block.firstTimestamp, sizeof(block.firstTimestamp));
+        in.read((char*)&block.lastTimestamp, sizeof(block.lastTimestamp));
+        in.read((char*)&block.count, sizeof(block.count));
+        in.read((char*)&block.minValue, sizeof(block.minValue));
+        in.read((char*)&block.maxValue, sizeof(block.maxValue));
+        in.read((char*)&block.sum, sizeof(block.sum));
+        in.read((char*)&block.bitCount, sizeof(block.bitCount));
+        block.words.resize((block.bitCount + 63) / 64);
+        in.read((char*)block.words.data(), block.words.size() * sizeof(uint64_t));
+        if (!in) {
+            throw runtime_error("[TelemetryBlock] Truncated block in spill file");
+        }
+        return block;
+    }
+
+    // Drops the payload but keeps the header (after spilling)
+    void releasePayload() {
+        words.clear();
+        words.shrink_to_fit();
+    }
+
+    size_t getByteSize() const {
+        return words.size() * sizeof(uint64_t);
+    }
+
+    size_t getSerializedSize() const {
+        return sizeof(firstTimestamp) + sizeof(lastTimestamp) + sizeof(count) +
+               sizeof(minValue) + sizeof(maxValue) + sizeof(sum) + sizeof(bitCount) +
+               getByteSize();
+    }
+
+    uint32_t getCount() const { return count; }
+    int64_t getFirstTimestamp() const { return firstTimestamp; }
+    int64_t getLastTimestamp() const { return lastTimestamp; }
+    double getMin() const { return minValue; }
+    double getMax() const { return maxValue; }
+    double getSum() const { return sum; }
+};
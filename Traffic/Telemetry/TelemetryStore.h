@@ -0,0 +1,393 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <map>
+#include <fstream>
+#include <cstdio>
+#include <memory>
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include "TelemetryBlock.h"
+
+using namespace std;
+
+enum class TelemetryMetric {
+    BRAKE_FORCE,
+    ENGINE_LOAD,
+    SPEED,
+    MILEAGE
+};
+
+const int TELEMETRY_METRIC_COUNT = 4;
+
+inline string telemetryMetricToString(TelemetryMetric metric) {
+    switch (metric) {
+        case TelemetryMetric::BRAKE_FORCE:
+            return "Brake Force";
+        case TelemetryMetric::ENGINE_LOAD:
+            return "Engine Load";
+        case TelemetryMetric::SPEED:
+            return "Speed";
+        case TelemetryMetric::MILEAGE:
+            return "Mileage";
+        default:
+            return "Unknown";
+    }
+}
+
+struct TelemetryConfig {
+    uint32_t blockSamples = 1024;                      // samples per compressed block
+    size_t maxInMemoryBlocks = 256;                    // per series, before spilling
+    int64_t rawRetentionMs = 24LL * 3600 * 1000;       // full-resolution history
+    int64_t rollupIntervalMs = 60 * 1000;              // downsampling bucket
+    int64_t rollupRetentionMs = 7LL * 24 * 3600 * 1000;
+    string spillPath = "";                             // spill file prefix; empty = never spill
+    int64_t spillSegmentMs = 3600 * 1000;              // time window per spill file
+};
+
+struct TelemetryAggregate {
+    uint64_t count = 0;
+    double sum = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+
+    void add(double value) {
+        if (count == 0) {
+            min = max = value;
+        } else {
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+        count++;
+        sum += value;
+    }
+
+    void merge(uint64_t otherCount, double otherSum, double otherMin, double otherMax) {
+        if (otherCount == 0) {
+            return;
+        }
+        if (count == 0) {
+            min = otherMin;
+            max = otherMax;
+        } else {
+            min = std::min(min, otherMin);
+            max = std::max(max, otherMax);
+        }
+        count += otherCount;
+        sum += otherSum;
+    }
+
+    double average() const {
+        return count == 0 ? 0.0 : sum / count;
+    }
+};
+
+struct TelemetryRollup {
+    int64_t bucketStart;
+    TelemetryAggregate stats;
+};
+
+// Spilled blocks, grouped into one file per time window of their first sample
+// ("<spillPath>.<window>"). Each file counts its live blocks and is deleted
+// once retention has dropped all of them, so disk use follows the raw
+// retention window instead of growing for as long as the store runs.
+// Files are only open while a block is written or read, so the number of
+// windows is not limited by the process's file descriptors.
+class TelemetrySpill {
+public:
+    struct Location {
+        int64_t window;
+        uint64_t offset;
+    };
+
+private:
+    struct Segment {
+        uint64_t bytes = 0;
+        size_t liveBlocks = 0;
+    };
+
+    string basePath;
+    int64_t windowMs;
+    map<int64_t, Segment> segments;
+
+    string pathOf(int64_t window) const {
+        return basePath + "." + to_string(window);
+    }
+
+public:
+    TelemetrySpill(string basePath, int64_t windowMs) : basePath(basePath), windowMs(windowMs) {}
+
+    TelemetrySpill(const TelemetrySpill&) = delete;
+    TelemetrySpill& operator=(const TelemetrySpill&) = delete;
+
+    ~TelemetrySpill() {
+        for (const auto& entry : segments) {
+            remove(pathOf(entry.first).c_str());
+        }
+    }
+
+    Location write(const TelemetryBlock& block) {
+        int64_t window = block.getFirstTimestamp() / windowMs;
+        bool created = !segments.count(window);
+        ofstream file(pathOf(window), ios::binary | (created ? ios::trunc : ios::app));
+        if (!file.is_open()) {
+            throw runtime_error("[TelemetrySpill] Cannot open spill file: " + pathOf(window));
+        }
+        block.writeTo(file);
+        if (!file) {
+            throw runtime_error("[TelemetrySpill] Cannot write spill file: " + pathOf(window));
+        }
+        Segment& segment = segments[window];
+        Location location{window, segment.bytes};
+        segment.bytes += block.getSerializedSize();
+        segment.liveBlocks++;
+        return location;
+    }
+
+    TelemetryBlock read(const Location& location) {
+        ifstream file(pathOf(location.window), ios::binary);
+        file.seekg((streamoff)location.offset);
+        return TelemetryBlock::readFrom(file);
+    }
+
+    // Called when retention drops a spilled block
+    void release(const Location& location) {
+        auto it = segments.find(location.window);
+        if (it == segments.end() || --it->second.liveBlocks > 0) {
+            return;
+        }
+        remove(pathOf(location.window).c_str());
+        segments.erase(it);
+    }
+
+    size_t getFileCount() const {
+        return segments.size();
+    }
+};
+
+// One metric of one train: a chain of sealed compressed blocks, the block
+// currently being filled, and per-interval rollups kept for longer than the
+// raw samples. Single writer; not thread-safe.
+class TelemetrySeries {
+private:
+    struct SealedBlock {
+        TelemetryBlock block;
+        bool spilled;
+        TelemetrySpill::Location location;
+    };
+
+    const TelemetryConfig& config;
+    TelemetrySpill* spill;
+    deque<SealedBlock> sealed;
+    size_t firstInMemory;  // oldest blocks spill first, so sealed[0, firstInMemory) are on disk
+    TelemetryBlock active;
+    deque<TelemetryRollup> rollups;
+    int64_t lastTimestamp;
+    bool hasSamples;
+
+    void seal() {
+        sealed.push_back({active, false, {0, 0}});
+        active = TelemetryBlock();
+
+        // Spill the oldest in-memory blocks beyond the budget (amortized O(1))
+        while (spill && sealed.size() - firstInMemory > config.maxInMemoryBlocks) {
+            SealedBlock& s = sealed[firstInMemory++];
+            s.location = spill->write(s.block);
+            s.block.releasePayload();
+            s.spilled = true;
+        }
+
+        // Raw retention: drop whole blocks that fell out of the window
+        while (!sealed.empty() && sealed.front().block.getLastTimestamp() < lastTimestamp - config.rawRetentionMs) {
+            if (sealed.front().spilled) {
+                spill->release(sealed.front().location);
+                firstInMemory--;
+            }
+            sealed.pop_front();
+        }
+    }
+
+    void updateRollup(int64_t timestamp, double value) {
+        int64_t bucket = timestamp - timestamp % config.rollupIntervalMs;
+        if (rollups.empty() || rollups.back().bucketStart != bucket) {
+            rollups.push_back({bucket, TelemetryAggregate()});
+            while (rollups.front().bucketStart < timestamp - config.rollupRetentionMs) {
+                rollups.pop_front();
+            }
+        }
+        rollups.back().stats.add(value);
+    }
+
+    vector<TelemetrySample> samplesOf(const SealedBlock& s) const {
+        if (!s.spilled) {
+            return s.block.decode();
+        }
+        return spill->read(s.location).decode();
+    }
+
+    template <typename Visit>
+    void forEachBlock(Visit visit) const {
+        for (const auto& s : sealed) {
+            visit(s.block, [&]() { return samplesOf(s); });
+        }
+        if (active.getCount() > 0) {
+            visit(active, [&]() { return active.decode(); });
+        }
+    }
+
+public:
+    TelemetrySeries(const TelemetryConfig& config, TelemetrySpill* spill)
+        : config(config), spill(spill), firstInMemory(0),
+          lastTimestamp(0), hasSamples(false) {}
+
+    // Returns false (sample dropped) if the timestamp goes backwards
+    bool append(int64_t timestamp, double value) {
+        if (hasSamples && timestamp < lastTimestamp) {
+            return false;
+        }
+        active.append(timestamp, value);
+        lastTimestamp = timestamp;
+        hasSamples = true;
+        updateRollup(timestamp, value);
+
+        if (active.getCount() >= config.blockSamples) {
+            seal();
+        }
+        return true;
+    }
+
+    // Raw samples with from <= timestamp <= to
+    vector<TelemetrySample> range(int64_t from, int64_t to) const {
+        vector<TelemetrySample> result;
+        forEachBlock([&](const TelemetryBlock& block, auto load) {
+            if (block.getLastTimestamp() < from || block.getFirstTimestamp() > to) {
+                return;
+            }
+            for (const auto& sample : load()) {
+                if (sample.timestamp >= from && sample.timestamp <= to) {
+                    result.push_back(sample);
+                }
+            }
+        });
+        return result;
+    }
+
+    // Blocks fully inside the range are answered from their headers
+    TelemetryAggregate aggregate(int64_t from, int64_t to) const {
+        TelemetryAggregate result;
+        forEachBlock([&](const TelemetryBlock& block, auto load) {
+            if (block.getLastTimestamp() < from || block.getFirstTimestamp() > to) {
+                return;
+            }
+            if (block.getFirstTimestamp() >= from && block.getLastTimestamp() <= to) {
+                result.merge(block.getCount(), block.getSum(), block.getMin(), block.getMax());
+                return;
+            }
+            for (const auto& sample : load()) {
+                if (sample.timestamp >= from && sample.timestamp <= to) {
+                    result.add(sample.value);
+                }
+            }
+        });
+        return result;
+    }
+
+    // Downsampled view (one point per rollup interval); outlives raw retention
+    vector<TelemetryRollup> downsample(int64_t from, int64_t to) const {
+        vector<TelemetryRollup> result;
+        for (const auto& rollup : rollups) {
+            if (rollup.bucketStart >= from && rollup.bucketStart <= to) {
+                result.push_back(rollup);
+            }
+        }
+        return result;
+    }
+
+    int64_t getLastTimestamp() const {
+        return lastTimestamp;
+    }
+
+    size_t getInMemoryBytes() const {
+        size_t bytes = active.getByteSize();
+        for (const auto& s : sealed) {
+            bytes += s.block.getByteSize();
+        }
+        return bytes;
+    }
+};
+
+// Telemetry for every train: one TelemetrySeries per (train, metric).
+// Hot ingest loops should hold on to the series reference returned by
+// series() instead of looking it up for every sample.
+class TelemetryStore {
+private:
+    TelemetryConfig config;
+    unique_ptr<TelemetrySpill> spill;
+    unordered_map<string, vector<TelemetrySeries>> seriesByTrain;
+
+public:
+    TelemetryStore(TelemetryConfig config = TelemetryConfig()) : config(config) {
+        if (config.blockSamples == 0 || config.rollupIntervalMs <= 0) {
+            throw invalid_argument("[TelemetryStore] Invalid block size or rollup interval");
+        }
+        // Otherwise a new rollup bucket would fall out of retention immediately
+        if (config.rollupRetentionMs < config.rollupIntervalMs) {
+            throw invalid_argument("[TelemetryStore] Rollup retention shorter than rollup interval");
+        }
+        if (!config.spillPath.empty()) {
+            if (config.spillSegmentMs <= 0) {
+                throw invalid_argument("[TelemetryStore] Invalid spill segment window");
+            }
+            spill = make_unique<TelemetrySpill>(config.spillPath, config.spillSegmentMs);
+        }
+        cout << "[TelemetryStore] Telemetry store initialized"
+             << (config.spillPath.empty() ? "" : " (spilling to " + config.spillPath + ")") << endl;
+    }
+
+    TelemetryStore(const TelemetryStore&) = delete;
+    TelemetryStore& operator=(const TelemetryStore&) = delete;
+
+    TelemetrySeries& series(const string& trainID, TelemetryMetric metric) {
+        auto it = seriesByTrain.find(trainID);
+        if (it == seriesByTrain.end()) {
+            vector<TelemetrySeries> metrics;
+            metrics.reserve(TELEMETRY_METRIC_COUNT);
+            for (int i = 0; i < TELEMETRY_METRIC_COUNT; i++) {
+                metrics.emplace_back(config, spill.get());
+            }
+            it = seriesByTrain.emplace(trainID, move(metrics)).first;
+        }
+        return it->second[(int)metric];
+    }
+
+    bool ingest(const string& trainID, TelemetryMetric metric, int64_t timestamp, double value) {
+        return series(trainID, metric).append(timestamp, value);
+    }
+
+    // Aggregate over the `windowMs` before the series' latest sample (e.g. last 24h)
+    TelemetryAggregate aggregateRecent(const string& trainID, TelemetryMetric metric, int64_t windowMs) {
+        TelemetrySeries& s = series(trainID, metric);
+        return s.aggregate(s.getLastTimestamp() - windowMs, s.getLastTimestamp());
+    }
+
+    size_t getTrainCount() const {
+        return seriesByTrain.size();
+    }
+
+    size_t getSpillFileCount() const {
+        return spill ? spill->getFileCount() : 0;
+    }
+
+    size_t getInMemoryBytes() const {
+        size_t bytes = 0;
+        for (const auto& entry : seriesByTrain) {
+            for (const auto& s : entry.second) {
+                bytes += s.getInMemoryBytes();
+            }
+        }
+        return bytes;
+    }
+};
@@ -5,6 +5,7 @@
 #include "../Brake/Brakes.h"
 #include "../Maintenance/MaintenanceLog.h"
 #include "../Maintenance/MaintenanceRecord.h"
+#include "../Telemetry/TelemetryStore.h"
 
 using namespace std;
 
@@ -40,9 +41,15 @@ public:
         cout << "\n[Train] T-" << this->ID << " has been KILLED!" << endl;
     }
 
-    void start() {
+    // Returns false if the train refused to start
+    bool start() {
         cout << "\n[Train] Starting train T-" << this->ID << "..." << endl;
 
+        if (isEmergencyPending()) {
+            cout << "[Train] Cannot start! Emergency stop in progress." << endl;
+            return false;
+        }
+
         if (needsMaintenance) {
             cout << "[Train] WARNING: Train needs maintenance!" << endl;
             cout << "[Train] Starting anyway (not recommended)..." << endl;
@@ -52,10 +59,14 @@ public:
             cout << "[Train] Cannot start! Brakes are still engaged." << endl;
             cout << "[Train] Releasing brakes first..." << endl;
             brake.release();
+            if (brake.engaged()) {
+                return false;
+            }
         }
 
         engine.start();
         cout << "[Train] T-" << this->ID << " is now moving!!" << endl;
+        return true;
     }
 
     void stop() {
@@ -77,16 +88,37 @@ public:
     }
 
     void emergencyStop() {
+        requestEmergencyStop();  // brakes engaged before any console output
         cout << "\n[Train] *** EMERGENCY STOP for train T-" << this->ID << " ***" << endl;
         brake.emergencyStop();
         engine.stop();
+        brake.acknowledgeEmergency();
         cout << "[Train] Emergency stop completed." << endl;
     }
 
-    void travel(int distance) {
+    // Real-time half of an emergency stop: engages and latches the brakes
+    // without I/O, allocation or locks, so it may be called from any thread.
+    // While latched the brakes cannot be released or lowered; the control
+    // thread finishes the stop (engine, logging) by calling emergencyStop()
+    // once it sees isEmergencyPending().
+    void requestEmergencyStop() noexcept {
+        brake.emergencyEngage();
+    }
+
+    bool isEmergencyPending() const noexcept {
+        return brake.emergencyLatched();
+    }
+
+    // Returns false if the distance is invalid or the train refused to move
+    bool travel(int distance) {
         if (distance <= 0) {
             cout << "[Train] Invalid distance!" << endl;
-            return;
+            return false;
+        }
+
+        if (isEmergencyPending()) {
+            cout << "[Train] Cannot travel! Emergency stop in progress." << endl;
+            return false;
         }
 
         mileage += distance;
@@ -99,6 +131,7 @@ public:
             cout << "[Train] !!! SCHEDULED MAINTENANCE REQUIRED at "
                  << mileage << " km !!!" << endl;
         }
+        return true;
     }
 
     // Perform maintenance (adds record to log)
@@ -141,6 +174,23 @@ public:
         maintenanceLog.exportToText();
     }
 
+    uint64_t exportMaintenanceSince(uint64_t watermark, ostream& out,
+                                    ExportFormat format = ExportFormat::TEXT) const {
+        return maintenanceLog.exportSince(watermark, out, format);
+    }
+
+    // Record the current engine/brake state as telemetry samples
+    void sampleTelemetry(TelemetryStore& store, int64_t timestamp) {
+        store.ingest(ID, TelemetryMetric::BRAKE_FORCE, timestamp, brake.getForce());
+        store.ingest(ID, TelemetryMetric::ENGINE_LOAD, timestamp,
+                     engine.running() ? engine.getPower() : 0);
+        store.ingest(ID, TelemetryMetric::MILEAGE, timestamp, mileage);
+    }
+
+    bool isEngineRunning() const { return engine.running(); }
+    bool isBrakeEngaged() const { return brake.engaged(); }
+    int getBrakeForce() const { return brake.getForce(); }
+
     bool requiresMaintenance() const {
         return needsMaintenance;
     }
@@ -150,12 +200,22 @@ public:
     string getID() const { return this->ID; }
     int getCapacity() const { return this->capacity; }
     int getMileage() const { return this->mileage; }
+    EngineType getEngineType() const { return engine.getEngineType(); }
+    int getEnginePower() const { return engine.getPower(); }
+    BrakeType getBrakeType() const { return brake.getBrakeType(); }
+    const MaintenanceLog& getMaintenanceLog() const { return maintenanceLog; }
     int getMaintenanceRecordCount() const {
         return maintenanceLog.getRecordCount();
     }
     double getTotalMaintenanceCost() const {
         return maintenanceLog.getTotalCost();
     }
+    vector<MaintenanceRecord> searchMaintenance(const string& query) const {
+        return maintenanceLog.searchDescriptions(query);
+    }
+    const CostAnalytics& getMaintenanceAnalytics() const {
+        return maintenanceLog.getAnalytics();
+    }
 
     void showStatus() {
         cout << "\n========================================" << endl;
@@ -0,0 +1,189 @@
+// Load generator for the fleet command server.
+//
+// Starts a CommandServer for a fleet of synthetic trains, then runs many
+// client threads, each keeping `depth` pipelined requests in flight on its
+// own connection. Reports commands per second and the reply statuses.
+//
+// Usage: CommandLoadGen [clients] [depth] [seconds] [trains]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../Traffic/Train/Train.h"
+#include "../Traffic/Fleet/Fleet.h"
+#include "../Traffic/Control/CommandServer.h"
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+static const char* SOCKET_PATH = "/tmp/metro_command_bench.sock";
+
+struct ClientResult {
+    uint64_t commands = 0;
+    uint64_t statusCounts[4] = {0, 0, 0, 0};
+    bool failed = false;
+};
+
+static int connectToServer() {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, SOCKET_PATH, sizeof(address.sun_path) - 1);
+    if (fd < 0 || connect(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+// Mostly travel commands, with start/stop cycles, some maintenance and the
+// occasional emergency stop
+static CommandRequest makeRequest(uint32_t id, uint32_t trainCount, uint32_t seed) {
+    CommandRequest request;
+    request.requestID = id;
+    request.trainID = "L-" + to_string(seed % trainCount);
+    uint32_t pick = (seed / trainCount) % 100;
+    if (pick < 60) {
+        request.opcode = CommandOpcode::TRAVEL;
+        request.distance = 1 + (int32_t)(seed % 50);
+    } else if (pick < 75) {
+        request.opcode = CommandOpcode::START;
+    } else if (pick < 85) {
+        request.opcode = CommandOpcode::STOP;
+    } else if (pick < 93) {
+        request.opcode = CommandOpcode::GRADUAL_STOP;
+    } else if (pick < 99) {
+        request.opcode = CommandOpcode::MAINTENANCE;
+        request.cost = 50.0 + seed % 500;
+        request.partName = "Brake Pads";
+        request.date = "2024-12-06";
+    } else {
+        request.opcode = CommandOpcode::EMERGENCY_STOP;
+    }
+    return request;
+}
+
+static void runClient(int clientIndex, int depth, uint32_t trainCount,
+                      Clock::time_point deadline, ClientResult& result) {
+    int fd = connectToServer();
+    if (fd < 0) {
+        result.failed = true;
+        return;
+    }
+
+    uint32_t nextID = 0;
+    uint32_t seed = 2654435761u * (uint32_t)(clientIndex + 1);
+    vector<char> requests;
+    vector<char> replies(depth * COMMAND_RESPONSE_SIZE);
+
+    while (Clock::now() < deadline) {
+        requests.clear();
+        for (int i = 0; i < depth; i++) {
+            seed = seed * 1664525u + 1013904223u;
+            CommandCodec::encodeRequest(requests, makeRequest(nextID++, trainCount, seed >> 8));
+        }
+        if (send(fd, requests.data(), requests.size(), MSG_NOSIGNAL) != (ssize_t)requests.size()) {
+            result.failed = true;
+            break;
+        }
+
+        size_t received = 0;
+        while (received < replies.size()) {
+            ssize_t n = recv(fd, replies.data() + received, replies.size() - received, 0);
+            if (n <= 0) {
+                result.failed = true;
+                close(fd);
+                return;
+            }
+            received += (size_t)n;
+        }
+        for (int i = 0; i < depth; i++) {
+            uint32_t id;
+            CommandStatus status;
+            CommandCodec::decodeResponse(replies.data() + i * COMMAND_RESPONSE_SIZE, id, status);
+            result.statusCounts[min<int>((int)status, 3)]++;
+        }
+        result.commands += depth;
+    }
+    close(fd);
+}
+
+int main(int argc, char** argv) {
+    int clients = argc > 1 ? atoi(argv[1]) : 8;
+    int depth = argc > 2 ? atoi(argv[2]) : 64;
+    double seconds = argc > 3 ? atof(argv[3]) : 3.0;
+    uint32_t trainCount = argc > 4 ? (uint32_t)atoi(argv[4]) : 1000;
+
+    // Train commands log every step; silence them (formatting is skipped)
+    streambuf* original = cout.rdbuf(nullptr);
+
+    vector<unique_ptr<Train>> trains;
+    Fleet fleet("Load Test");
+    for (uint32_t i = 0; i < trainCount; i++) {
+        trains.push_back(make_unique<Train>("L-" + to_string(i), 500,
+            "E", 1500, EngineType::ELECTRIC, "B", BrakeType::REGENERATIVE));
+        fleet.addTrain(*trains.back());
+    }
+
+    uint64_t handled;
+    vector<ClientResult> results(clients);
+    {
+        CommandServer server(fleet, SOCKET_PATH);
+        thread serverThread([&server]() { server.run(); });
+
+        auto start = Clock::now();
+        auto deadline = start + chrono::duration_cast<Clock::duration>(chrono::duration<double>(seconds));
+        vector<thread> clientThreads;
+        for (int c = 0; c < clients; c++) {
+            clientThreads.emplace_back(runClient, c, depth, trainCount, deadline, ref(results[c]));
+        }
+        for (auto& t : clientThreads) {
+            t.join();
+        }
+        seconds = chrono::duration<double>(Clock::now() - start).count();
+
+        server.requestStop();
+        serverThread.join();
+        handled = server.getCommandsHandled();
+    }
+
+    cout.rdbuf(original);
+    cout.clear();
+
+    ClientResult total;
+    int failedClients = 0;
+    for (const auto& r : results) {
+        total.commands += r.commands;
+        for (int s = 0; s < 4; s++) {
+            total.statusCounts[s] += r.statusCounts[s];
+        }
+        failedClients += r.failed ? 1 : 0;
+    }
+
+    cout << "\n=== COMMAND SERVER LOAD TEST ===" << endl;
+    cout << "  Clients: " << clients << ", pipeline depth: " << depth
+         << ", trains: " << trainCount << endl;
+    cout << "  Commands completed: " << total.commands << " (server handled " << handled << ")" << endl;
+    cout << "  Throughput: " << fixed << setprecision(0) << total.commands / seconds << " commands/s" << endl;
+    for (int s = 0; s < 4; s++) {
+        if (total.statusCounts[s] > 0) {
+            cout << "  " << commandStatusToString((CommandStatus)s) << ": " << total.statusCounts[s] << endl;
+        }
+    }
+    if (failedClients > 0) {
+        cout << "  Clients with connection errors: " << failedClients << endl;
+    }
+    cout << "================================\n" << endl;
+
+    cout.rdbuf(nullptr);  // Train destructor output
+    return failedClients > 0 ? 1 : 0;
+}
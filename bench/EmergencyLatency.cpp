@@ -0,0 +1,166 @@
+// Emergency stop latency harness.
+//
+// A control thread keeps one train busy with normal commands while background
+// threads load every core. A commander thread repeatedly issues the real-time
+// emergency stop and measures:
+//   - command -> brake engaged    (the requestEmergencyStop() call itself)
+//   - command -> seen by observer (another thread spinning on the brake state)
+//   - command -> stop completed   (control thread pre-empts its queue)
+//
+// Usage: EmergencyLatency [iterations] [background threads]
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include <cstdlib>
+#include "../Traffic/Train/Train.h"
+#include "../Traffic/Control/TrainCommandQueue.h"
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+static int64_t nowNs() {
+    return chrono::duration_cast<chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+static void report(const string& name, vector<int64_t>& samples) {
+    if (samples.empty()) {
+        cout << "  " << name << ": no samples" << endl;
+        return;
+    }
+    sort(samples.begin(), samples.end());
+    auto at = [&](double q) { return samples[min(samples.size() - 1, (size_t)(q * samples.size()))]; };
+    cout << "  " << name << " (" << samples.size() << " samples)" << endl;
+    cout << "    p50    = " << at(0.50) << " ns" << endl;
+    cout << "    p99    = " << at(0.99) << " ns" << endl;
+    cout << "    p99.99 = " << at(0.9999) << " ns" << endl;
+    cout << "    max    = " << samples.back() << " ns" << endl;
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 20000;
+    unsigned backgroundThreads = argc > 2 ? (unsigned)atoi(argv[2]) : thread::hardware_concurrency();
+
+    // Train operations log heavily; keep the formatting cost, drop the output
+    ostringstream sink;
+    streambuf* original = cout.rdbuf(sink.rdbuf());
+
+    Train train("BENCH", 500, "E-B", 1500, EngineType::ELECTRIC, "B-B", BrakeType::HYDRAULIC);
+    TrainCommandQueue queue(train);
+
+    atomic<bool> running(true);
+    atomic<int64_t> issuedAt(0);
+    atomic<int> armed(0);       // emergencies issued
+    atomic<int> observed(0);    // emergencies the observer is done with
+    atomic<int> completed(0);   // emergencies handled by the control thread
+    int missed = 0;             // cleared again before the observer saw them
+    vector<int64_t> engagedLatency;
+    vector<int64_t> visibleLatency;
+    vector<int64_t> completedLatency;
+    engagedLatency.reserve(iterations);
+    visibleLatency.reserve(iterations);
+    completedLatency.reserve(iterations);
+
+    // Background load: allocation- and hash-heavy busy work on every core
+    vector<thread> load;
+    for (unsigned i = 0; i < backgroundThreads; i++) {
+        load.emplace_back([&running, i]() {
+            unordered_map<int, vector<int>> table;
+            int n = (int)i;
+            while (running.load(memory_order_relaxed)) {
+                table[n % 4096].assign(64, n);
+                n = n * 1103515245 + 12345;
+                if (table.size() > 4000) {
+                    table.clear();
+                }
+            }
+        });
+    }
+
+    // Control loop: keeps normal commands flowing and completes emergencies
+    thread control([&]() {
+        int tick = 0;
+        while (running.load(memory_order_relaxed)) {
+            if (tick++ % 4 == 0) {
+                queue.submit({TrainCommandType::START});
+                queue.submit({TrainCommandType::TRAVEL, 5});
+                queue.submit({TrainCommandType::GRADUAL_STOP});
+                if (sink.tellp() > (1 << 20)) {
+                    sink.str("");
+                }
+            }
+            if (queue.process()) {
+                completedLatency.push_back(nowNs() - issuedAt.load(memory_order_acquire));
+                completed.fetch_add(1, memory_order_release);
+            }
+        }
+    });
+
+    // Observer: how long until another core sees the engaged brake. Spins
+    // without sleeping, yielding now and then so it cannot starve the others
+    // on a machine with few cores.
+    thread observer([&]() {
+        for (int expected = 1; expected <= iterations; expected++) {
+            while (armed.load(memory_order_acquire) < expected) {
+                if (!running.load(memory_order_relaxed)) {
+                    return;
+                }
+                this_thread::yield();
+            }
+            for (uint32_t spins = 1; ; spins++) {
+                if (train.isEmergencyPending() && train.isBrakeEngaged()) {
+                    visibleLatency.push_back(nowNs() - issuedAt.load(memory_order_acquire));
+                    break;
+                }
+                if (completed.load(memory_order_acquire) >= expected) {
+                    missed++;
+                    break;
+                }
+                if (spins % 1024 == 0) {
+                    this_thread::yield();
+                }
+            }
+            observed.store(expected, memory_order_release);
+        }
+    });
+
+    for (int i = 0; i < iterations; i++) {
+        while (train.isEmergencyPending() || observed.load(memory_order_acquire) < i) {
+            this_thread::yield();
+        }
+        this_thread::sleep_for(chrono::microseconds(i % 50));
+
+        int64_t start = nowNs();
+        issuedAt.store(start, memory_order_release);
+        armed.store(i + 1, memory_order_release);
+        queue.emergencyStop();
+        int64_t engaged = nowNs();  // brakes are engaged once the call returns
+        engagedLatency.push_back(engaged - start);
+    }
+    while (train.isEmergencyPending() || observed.load(memory_order_acquire) < iterations) {
+        this_thread::yield();
+    }
+
+    running.store(false);
+    observer.join();
+    control.join();
+    for (auto& t : load) {
+        t.join();
+    }
+    cout.rdbuf(original);
+
+    cout << "\n=== EMERGENCY STOP LATENCY ===" << endl;
+    cout << "  Iterations: " << iterations << ", background threads: " << backgroundThreads << endl;
+    report("Command -> brake engaged", engagedLatency);
+    report("Command -> visible to observer thread", visibleLatency);
+    if (missed > 0) {
+        cout << "  Observer missed " << missed << " emergencies (already cleared)" << endl;
+    }
+    report("Command -> stop completed by control thread", completedLatency);
+    cout << "==============================\n" << endl;
+    return 0;
+}
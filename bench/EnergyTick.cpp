@@ -0,0 +1,71 @@
+// FleetEnergyModel tick benchmark.
+//
+// Builds a fleet of synthetic trains of every engine and brake type, gives
+// each a varying throttle/speed/brake state, and times tick() over the whole
+// fleet. Reports the time per tick and per train.
+//
+// Usage: EnergyTick [trains] [ticks]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include "../Traffic/Train/Train.h"
+#include "../Traffic/Energy/FleetEnergyModel.h"
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+int main(int argc, char** argv) {
+    int trainCount = argc > 1 ? atoi(argv[1]) : 100000;
+    int ticks = argc > 2 ? atoi(argv[2]) : 1000;
+    if (trainCount <= 0 || ticks <= 0) {
+        cout << "Train and tick counts must be positive" << endl;
+        return 1;
+    }
+
+    // Train construction logs every step; silence it (formatting is skipped)
+    streambuf* original = cout.rdbuf(nullptr);
+
+    const EngineType engines[] = {EngineType::ELECTRIC, EngineType::DIESEL,
+                                  EngineType::HYBRID, EngineType::MAGNETIC_LEVITATION};
+    vector<unique_ptr<Train>> trains;
+    EnergyLedger ledger;
+    FleetEnergyModel model(ledger);
+    for (int i = 0; i < trainCount; i++) {
+        trains.push_back(make_unique<Train>("N-" + to_string(i), 200 + i % 800,
+            "E", 1000 + i % 2000, engines[i % 4], "B",
+            i % 3 == 0 ? BrakeType::REGENERATIVE : BrakeType::HYDRAULIC));
+        size_t index = model.addTrain(*trains.back());
+        model.setState(index, (i % 10) / 10.0, 5.0 + i % 20, (i % 7) / 7.0);
+    }
+
+    vector<double> tickNs;
+    tickNs.reserve(ticks);
+    for (int t = 0; t < ticks; t++) {
+        auto start = Clock::now();
+        model.tick(1.0);
+        tickNs.push_back(chrono::duration<double, nano>(Clock::now() - start).count());
+    }
+    model.flush();
+
+    cout.rdbuf(original);
+    cout.clear();
+
+    sort(tickNs.begin(), tickNs.end());
+    double median = tickNs[tickNs.size() / 2];
+    cout << "\n=== ENERGY MODEL TICK ===" << endl;
+    cout << "  Trains: " << trainCount << ", ticks: " << ticks << endl;
+    cout << fixed << setprecision(1);
+    cout << "  Tick p50: " << median / 1000.0 << " us ("
+         << median / trainCount << " ns per train)" << endl;
+    cout << "  Tick max: " << tickNs.back() / 1000.0 << " us" << endl;
+    cout << "  Fleet traction: " << ledger.getTypeAccount(EngineType::ELECTRIC).tractionKWh
+         << " kWh (electric)" << endl;
+    cout << "=========================\n" << endl;
+
+    cout.rdbuf(nullptr);  // Train destructor output
+    return 0;
+}
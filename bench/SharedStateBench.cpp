@@ -0,0 +1,123 @@
+// Shared-memory fleet state benchmark.
+//
+// The parent process owns the trains and publishes their state; reader
+// processes are forked and take full-fleet snapshots in a tight loop.
+// Reports reader snapshot throughput and how much the readers slow the writer
+// compared with publishing alone.
+//
+// Usage: SharedStateBench [trains] [readers] [seconds]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../Traffic/Train/Train.h"
+#include "../Traffic/SharedState/FleetStateSegment.h"
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+static const char* SEGMENT_NAME = "/metro_state_bench";
+
+static uint64_t runWriter(FleetStateSegment& segment, vector<unique_ptr<Train>>& trains, double seconds) {
+    uint64_t updates = 0;
+    auto deadline = Clock::now() + chrono::duration<double>(seconds);
+    while (Clock::now() < deadline) {
+        for (uint32_t i = 0; i < trains.size(); i++) {
+            trains[i]->travel(1);
+            segment.publish(i, *trains[i]);
+        }
+        updates += trains.size();
+    }
+    return updates;
+}
+
+// Child process body: returns snapshots taken
+static uint64_t runReader(double seconds) {
+    FleetStateSegment segment = FleetStateSegment::open(SEGMENT_NAME);
+    uint64_t snapshots = 0;
+    int64_t checksum = 0;
+    auto deadline = Clock::now() + chrono::duration<double>(seconds);
+    while (Clock::now() < deadline) {
+        for (uint32_t i = 0; i < segment.getTrainCount(); i++) {
+            checksum += segment.read(i).mileage;
+        }
+        snapshots += segment.getTrainCount();
+    }
+    return checksum == -1 ? 0 : snapshots;  // keep the reads observable
+}
+
+int main(int argc, char** argv) {
+    uint32_t trainCount = argc > 1 ? (uint32_t)atoi(argv[1]) : 256;
+    int readerCount = argc > 2 ? atoi(argv[2]) : 4;
+    double seconds = argc > 3 ? atof(argv[3]) : 2.0;
+
+    // Silence train logging (stream goes bad, formatting is skipped)
+    streambuf* original = cout.rdbuf(nullptr);
+
+    vector<unique_ptr<Train>> trains;
+    for (uint32_t i = 0; i < trainCount; i++) {
+        trains.push_back(make_unique<Train>("B-" + to_string(i), 500,
+            "E", 1500, EngineType::ELECTRIC, "B", BrakeType::HYDRAULIC));
+    }
+    FleetStateSegment segment = FleetStateSegment::create(SEGMENT_NAME, trainCount);
+    for (uint32_t i = 0; i < trainCount; i++) {
+        segment.publish(i, *trains[i]);
+    }
+
+    uint64_t aloneUpdates = runWriter(segment, trains, seconds);
+
+    vector<pid_t> children;
+    vector<int> pipes;
+    for (int r = 0; r < readerCount; r++) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            cerr << "[SharedStateBench] pipe failed" << endl;
+            return 1;
+        }
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            uint64_t snapshots = runReader(seconds);
+            ssize_t written = write(fds[1], &snapshots, sizeof(snapshots));
+            _exit(written == sizeof(snapshots) ? 0 : 1);
+        }
+        close(fds[1]);
+        children.push_back(pid);
+        pipes.push_back(fds[0]);
+    }
+
+    uint64_t contendedUpdates = runWriter(segment, trains, seconds);
+
+    uint64_t totalSnapshots = 0;
+    for (int r = 0; r < readerCount; r++) {
+        uint64_t snapshots = 0;
+        if (read(pipes[r], &snapshots, sizeof(snapshots)) == sizeof(snapshots)) {
+            totalSnapshots += snapshots;
+        }
+        close(pipes[r]);
+        waitpid(children[r], nullptr, 0);
+    }
+    segment.unlink();
+
+    cout.rdbuf(original);
+    cout.clear();
+    double aloneRate = aloneUpdates / seconds;
+    double contendedRate = contendedUpdates / seconds;
+    cout << "\n=== SHARED FLEET STATE BENCHMARK ===" << endl;
+    cout << "  Trains: " << trainCount << ", readers: " << readerCount
+         << ", duration: " << seconds << " s per phase" << endl;
+    cout << fixed << setprecision(2);
+    cout << "  Writer alone:        " << aloneRate / 1e6 << " M updates/s" << endl;
+    cout << "  Writer with readers: " << contendedRate / 1e6 << " M updates/s ("
+         << (aloneRate > 0 ? 100.0 * (1.0 - contendedRate / aloneRate) : 0.0) << "% slower)" << endl;
+    cout << "  Reader snapshots:    " << totalSnapshots / seconds / 1e6 << " M/s total, "
+         << (readerCount > 0 ? totalSnapshots / seconds / 1e6 / readerCount : 0.0) << " M/s per reader" << endl;
+    cout << "====================================\n" << endl;
+
+    cout.rdbuf(nullptr);  // Train destructor output
+    return 0;
+}
@@ -0,0 +1,153 @@
+// Round-trip check for the Gorilla telemetry codec and the spill files.
+//
+// Encodes samples with random bit-pattern values (NaNs, infinities and
+// denormals included) and timestamps with irregular gaps and large jumps, then
+// checks that every sample decodes back bit for bit: straight from a
+// TelemetryBlock, and through a TelemetryStore small enough that most blocks
+// are spilled to disk. Finally lets retention expire the spilled blocks and
+// checks that their spill files are deleted.
+//
+// Usage: TelemetryRoundTrip [samples] [seed]
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include <cstring>
+#include "../Traffic/Telemetry/TelemetryStore.h"
+
+using namespace std;
+
+static const char* SPILL_PATH = "/tmp/metro_telemetry_roundtrip";
+
+static int failures = 0;
+
+static void check(bool condition, const string& what) {
+    if (!condition) {
+        cout << "  FAILED: " << what << endl;
+        failures++;
+    }
+}
+
+static bool sameSample(const TelemetrySample& a, const TelemetrySample& b) {
+    return a.timestamp == b.timestamp && memcmp(&a.value, &b.value, sizeof(double)) == 0;
+}
+
+static vector<TelemetrySample> makeSamples(size_t n, mt19937_64& rng) {
+    vector<TelemetrySample> samples;
+    samples.reserve(n);
+    int64_t timestamp = 1'700'000'000'000LL;
+    double value = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t pick = rng() % 100;
+        if (pick < 50) {
+            timestamp += 1000;                                 // steady rate
+        } else if (pick < 80) {
+            timestamp += (int64_t)(rng() % 5000);              // jitter, repeats
+        } else if (pick < 95) {
+            timestamp += (int64_t)(rng() % 10'000'000);        // outage
+        } else {
+            timestamp += (int64_t)(rng() % (1LL << 40));       // huge jump
+        }
+
+        pick = rng() % 100;
+        if (pick < 30) {
+            // unchanged value
+        } else if (pick < 60) {
+            value += (double)(int64_t)(rng() % 200 - 100) / 8.0;
+        } else {
+            uint64_t bits = rng();
+            memcpy(&value, &bits, sizeof(value));
+        }
+        samples.push_back({timestamp, value});
+    }
+    return samples;
+}
+
+static void checkBlocks(const vector<TelemetrySample>& samples) {
+    for (size_t blockSize : {(size_t)1, (size_t)2, (size_t)7, (size_t)1024, samples.size()}) {
+        for (size_t start = 0; start < samples.size(); start += blockSize) {
+            size_t end = min(samples.size(), start + blockSize);
+            TelemetryBlock block;
+            for (size_t i = start; i < end; i++) {
+                block.append(samples[i].timestamp, samples[i].value);
+            }
+            vector<TelemetrySample> decoded = block.decode();
+            bool same = decoded.size() == end - start;
+            for (size_t i = 0; same && i < decoded.size(); i++) {
+                same = sameSample(decoded[i], samples[start + i]);
+            }
+            check(same, "block of " + to_string(blockSize) + " at sample " + to_string(start));
+            if (!same) {
+                return;
+            }
+        }
+    }
+}
+
+static void checkSpill(const vector<TelemetrySample>& samples) {
+    TelemetryConfig config;
+    config.blockSamples = 64;
+    config.maxInMemoryBlocks = 2;
+    config.rawRetentionMs = 1LL << 62;  // keep everything for the first pass
+    config.rollupIntervalMs = 1LL << 40;
+    config.rollupRetentionMs = 1LL << 41;
+    config.spillPath = SPILL_PATH;
+    config.spillSegmentMs = 1LL << 36;
+
+    TelemetryStore store(config);
+    TelemetrySeries& series = store.series("RT-1", TelemetryMetric::SPEED);
+    for (const auto& sample : samples) {
+        check(series.append(sample.timestamp, sample.value), "append");
+    }
+    check(store.getSpillFileCount() > 0, "blocks were spilled");
+
+    vector<TelemetrySample> decoded = series.range(samples.front().timestamp, samples.back().timestamp);
+    bool same = decoded.size() == samples.size();
+    for (size_t i = 0; same && i < decoded.size(); i++) {
+        same = sameSample(decoded[i], samples[i]);
+    }
+    check(same, "range() over spilled blocks");
+    cout << "  " << samples.size() << " samples through " << store.getSpillFileCount()
+         << " spill files" << endl;
+}
+
+static void checkSpillExpiry() {
+    TelemetryConfig config;
+    config.blockSamples = 16;
+    config.maxInMemoryBlocks = 1;
+    config.rawRetentionMs = 10'000;
+    config.spillPath = SPILL_PATH;
+    config.spillSegmentMs = 1000;
+
+    TelemetryStore store(config);
+    TelemetrySeries& series = store.series("RT-2", TelemetryMetric::BRAKE_FORCE);
+    size_t mostFiles = 0;
+    for (int64_t t = 0; t < 200'000; t += 10) {
+        series.append(t, (double)(t % 977));
+        mostFiles = max(mostFiles, store.getSpillFileCount());
+    }
+    // Retention keeps ~10 s of samples, i.e. about 10 one-second windows
+    check(mostFiles <= 12, "expired spill files deleted (peak " + to_string(mostFiles) + ")");
+    TelemetryAggregate recent = store.aggregateRecent("RT-2", TelemetryMetric::BRAKE_FORCE, 5000);
+    check(recent.count == 501, "aggregate over retained blocks");
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? (size_t)atol(argv[1]) : 100000;
+    uint64_t seed = argc > 2 ? (uint64_t)atoll(argv[2]) : 42;
+    if (count == 0) {
+        cout << "Sample count must be positive" << endl;
+        return 1;
+    }
+
+    mt19937_64 rng(seed);
+    vector<TelemetrySample> samples = makeSamples(count, rng);
+
+    cout << "\n=== TELEMETRY ROUND TRIP ===" << endl;
+    checkBlocks(samples);
+    checkSpill(samples);
+    checkSpillExpiry();
+    cout << (failures == 0 ? "  All checks passed" : "  Checks failed: " + to_string(failures)) << endl;
+    cout << "============================\n" << endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -2,6 +2,9 @@
 #include "Traffic/Brake/Brakes.h"
 #include "Traffic/Engine/Engine.h"
 #include "Traffic/Train/Train.h"
+#include "Traffic/Fleet/Fleet.h"
+#include "Traffic/Fleet/FleetQuery.h"
+#include "Traffic/Energy/EnergyLedger.h"
 
 int main() {
 
@@ -204,6 +207,40 @@ int main() {
     cout << "  - Maintenance Records: " << metro2.getMaintenanceRecordCount() << endl;
     cout << "  - Total Maintenance Cost: $" << metro2.getTotalMaintenanceCost() << endl;
 
+    // ============================================
+    // Fleet-wide Queries
+    // ============================================
+    cout << "\n=== FLEET QUERIES ===" << endl;
+    Fleet fleet("Smart Metro");
+    fleet.addTrain(metro1);
+    fleet.addTrain(metro2);
+
+    FleetQuery::showResults("COST BY PART",
+        FleetQuery().groupBy(FleetQuery::byPart()).run(fleet));
+    FleetQuery::showResults("COST BY ENGINE TYPE",
+        FleetQuery().groupBy(FleetQuery::byEngineType()).run(fleet));
+    FleetQuery::showResults("BRAKE WORK BY TECHNICIAN",
+        FleetQuery()
+            .where([](const Train&, const MaintenanceRecord& r) {
+                return r.getPartName().find("Brake") != string::npos;
+            })
+            .groupBy(FleetQuery::byTechnician())
+            .run(fleet));
+
+    cout << "\nRecords mentioning \"worn OR inspect*\":" << endl;
+    for (const auto& match : fleet.searchMaintenance("worn OR inspect*")) {
+        cout << "  T-" << match.train->getID() << " " << match.record() << endl;
+    }
+
+    // ============================================
+    // Energy Accounting
+    // ============================================
+    cout << "\n=== ENERGY ACCOUNTING ===" << endl;
+    EnergyLedger energy;
+    energy.recordTrip(metro1, metro1.getMileage(), 4);
+    energy.recordTrip(metro2, metro2.getMileage(), 1);
+    energy.showReport();
+
     cout << "\n================================================" << endl;
     cout << "   End of Demo - Trains will be destroyed" << endl;
     cout << "================================================\n" << endl;